@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/renderer/animated_sprite.hpp"
+#include "../src/renderer/animation_frame_table.hpp"
+#include "../src/renderer/animation_system.hpp"
+#include "../src/renderer/quad_geometry.hpp"
+#include "../src/renderer/shader.hpp"
+#include "../src/renderer/sprite_batch.hpp"
+#include "../src/renderer/texture_2d.hpp"
+#include "../src/renderer/transform_store.hpp"
+#include "../src/resources/thread_pool.hpp"
+#include "null_gl.hpp"
+
+// Per-frame update of 50k animated sprites at 60 fps, each running an 8-frame
+// walk cycle from a tile sheet: AnimatedSprite with its compiled frame table
+// against the old layout, which kept (tile name, duration) pairs and resolved
+// the tile by name in a std::map whenever the frame changed, and against the
+// AnimationSystem stepping all of them into a TransformStore, on the calling
+// thread and on a thread pool. The last two lines add the instanced batch
+// submit, for the AnimationSystem and for sprites animated by
+// sprite_animated.vert, which need no stepping at all; those two are timed in
+// alternating rounds, best round each.
+
+namespace{
+    const size_t sprite_count = 50000;
+    const size_t frames = 300;
+    const uint64_t frame_time_us = 16667;
+    const size_t walk_frames = 8;
+
+    // the data layout AnimatedSprite had before its frame tables, with the
+    // std::map Texture2D kept its tiles in
+    class StringAnimatedSprite : public Renderer::Sprite{
+    public:
+        StringAnimatedSprite(const std::map<std::string, Renderer::Texture2D::Tile>& tiles,
+                             const std::shared_ptr<Renderer::Texture2D>& p_texture,
+                             const std::shared_ptr<Renderer::QuadGeometry>& p_quad_geometry)
+                             : Sprite(p_texture, "", nullptr, p_quad_geometry), m_tiles(tiles){}
+
+        void insert_state(std::string state, std::vector<std::pair<std::string, size_t>> frame_duration){
+            m_states_map.emplace(std::move(state), std::move(frame_duration));
+        }
+
+        void set_state(const std::string& state){
+            m_p_frames = &m_states_map.find(state)->second;
+            m_current_frame = 0;
+            m_current_animation_time = 0;
+        }
+
+        void update(const uint64_t delta){
+            m_current_animation_time += delta;
+            while (m_current_animation_time >= (*m_p_frames)[m_current_frame].second){
+                m_current_animation_time -= (*m_p_frames)[m_current_frame].second;
+                m_current_frame = (m_current_frame + 1) % m_p_frames->size();
+                m_tile = m_tiles.find((*m_p_frames)[m_current_frame].first)->second;
+            }
+        }
+
+    private:
+        const std::map<std::string, Renderer::Texture2D::Tile>& m_tiles;
+        std::map<std::string, std::vector<std::pair<std::string, size_t>>> m_states_map;
+        const std::vector<std::pair<std::string, size_t>>* m_p_frames = nullptr;
+        size_t m_current_frame = 0;
+        uint64_t m_current_animation_time = 0;
+    };
+
+    template<typename Frame>
+    void measure(const char* name, Frame frame){
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames; ++i){
+            frame();
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        std::cout << "  " << name << ": " << std::chrono::duration<double, std::milli>(finish - start).count() / frames
+                  << " ms/frame" << std::endl;
+    }
+
+    // Alternates rounds of the two and keeps the best round of each, so drift
+    // and background load hit both alike instead of whichever runs last.
+    template<typename First, typename Second>
+    void measure_interleaved(const char* first_name, First first, const char* second_name, Second second){
+        const size_t rounds = 10;
+        const auto round_ms = [](auto& frame){
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < frames / rounds; ++i){
+                frame();
+            }
+            const auto finish = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::milli>(finish - start).count() / (frames / rounds);
+        };
+        first();
+        second();
+        double first_ms = std::numeric_limits<double>::max();
+        double second_ms = std::numeric_limits<double>::max();
+        for (size_t round = 0; round < rounds; ++round){
+            first_ms = std::min(first_ms, round_ms(first));
+            second_ms = std::min(second_ms, round_ms(second));
+        }
+        std::cout << "  " << first_name << ": " << first_ms << " ms/frame" << std::endl
+                  << "  " << second_name << ": " << second_ms << " ms/frame" << std::endl;
+    }
+}
+
+int main(){
+    NullGL::load();
+
+    auto texture = std::make_shared<Renderer::Texture2D>(256, 32, nullptr, 4, GL_NEAREST);
+    std::map<std::string, Renderer::Texture2D::Tile> tiles_by_name;
+    std::vector<std::pair<std::string, uint64_t>> walk;
+    std::vector<std::pair<std::string, size_t>> string_walk;
+    for (size_t i = 0; i < walk_frames; ++i){
+        const std::string name = "character_walk_right_" + std::to_string(i);
+        const glm::vec2 left_bottom_uv(i / static_cast<float>(walk_frames), 0.0f);
+        const glm::vec2 right_top_uv((i + 1) / static_cast<float>(walk_frames), 1.0f);
+        texture->add_tile(name, left_bottom_uv, right_top_uv);
+        tiles_by_name.emplace(name, Renderer::Texture2D::Tile(left_bottom_uv, right_top_uv));
+        walk.emplace_back(name, 100000);
+        string_walk.emplace_back(name, 100000);
+    }
+    auto quad_geometry = std::make_shared<Renderer::QuadGeometry>();
+
+    std::mt19937 random(3);
+    std::vector<std::unique_ptr<Renderer::AnimatedSprite>> sprites;
+    std::vector<std::unique_ptr<StringAnimatedSprite>> string_sprites;
+    Renderer::TransformStore transforms;
+    Renderer::AnimationSystem animation_system;
+    const Renderer::AnimationSystem::AnimationId walk_animation = animation_system.add_animation(*texture, walk);
+    sprites.reserve(sprite_count);
+    string_sprites.reserve(sprite_count);
+    for (size_t i = 0; i < sprite_count; ++i){
+        sprites.push_back(std::make_unique<Renderer::AnimatedSprite>(texture, "character_walk_right_0", nullptr, quad_geometry));
+        sprites.back()->insert_state("walk", walk);
+        sprites.back()->set_state("walk");
+        // desynchronise the sprites
+        const uint64_t offset = random() % 800000;
+        sprites.back()->update(offset);
+        string_sprites.push_back(std::make_unique<StringAnimatedSprite>(tiles_by_name, texture, quad_geometry));
+        string_sprites.back()->insert_state("walk", string_walk);
+        string_sprites.back()->set_state("walk");
+        string_sprites.back()->update(offset);
+        const Renderer::TransformStore::Index sprite = transforms.add(glm::vec2(random() % 1270, random() % 720), glm::vec2(32.0f));
+        animation_system.add(transforms, sprite, walk_animation, offset);
+    }
+
+    std::cout << sprite_count << " animated sprites, " << walk_frames << " frames of 100 ms" << std::endl;
+    measure("tile names + std::map  ", [&](){
+        for (const std::unique_ptr<StringAnimatedSprite>& sprite : string_sprites){
+            sprite->update(frame_time_us);
+        }
+    });
+    measure("AnimatedSprite::update ", [&](){
+        for (const std::unique_ptr<Renderer::AnimatedSprite>& sprite : sprites){
+            sprite->update(frame_time_us);
+        }
+    });
+    measure("AnimationSystem        ", [&](){
+        animation_system.update(frame_time_us, transforms);
+    });
+    ThreadPool thread_pool(ThreadPool::default_thread_count());
+    measure("AnimationSystem, pool  ", [&](){
+        animation_system.update(frame_time_us, transforms, &thread_pool);
+    });
+
+    const Renderer::ShaderProgram shader_program("", "");
+    Renderer::SpriteBatch batch(quad_geometry, Renderer::SpriteBatch::Mode::Instanced);
+    Renderer::AnimationFrameTable animation_frames;
+    std::vector<std::string> walk_tiles;
+    for (const auto& frame : walk){
+        walk_tiles.push_back(frame.first);
+    }
+    const Renderer::AnimationFrameTable::Animation gpu_walk = animation_frames.add_animation(*texture, walk_tiles, 0.1f);
+    Renderer::TransformStore gpu_transforms;
+    for (size_t i = 0; i < sprite_count; ++i){
+        gpu_transforms.add(transforms.position(static_cast<Renderer::TransformStore::Index>(i)), glm::vec2(32.0f), 0.0f,
+                           Renderer::AnimationFrameTable::instance_animation(gpu_walk, (random() % 800) / 1000.0f));
+    }
+    measure_interleaved("AnimationSystem + batch", [&](){
+        animation_system.update(frame_time_us, transforms);
+        batch.begin();
+        batch.submit(texture.get(), &shader_program, transforms);
+        batch.end();
+    }, "GPU animation + batch  ", [&](){
+        animation_frames.bind();
+        batch.begin();
+        batch.submit(texture.get(), &shader_program, gpu_transforms);
+        batch.end();
+    });
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../src/renderer/dynamic_atlas.hpp"
+#include "../src/renderer/quad_geometry.hpp"
+#include "../src/renderer/render_queue.hpp"
+#include "../src/renderer/shader.hpp"
+#include "../src/renderer/sprite_batch.hpp"
+#include "../src/renderer/texture_2d.hpp"
+#include "null_gl.hpp"
+
+// Loose sprite images of random sizes, drawn in random order through the
+// RenderQueue into a SpriteBatch: once as one Texture2D per image, once packed
+// into DynamicAtlas pages. Reports packing efficiency, pages, draws per frame
+// and the CPU time of packing and of queue + batch (GL calls are stubs).
+
+namespace{
+    const size_t image_count = 600;
+    const unsigned int min_image_size = 8;
+    const unsigned int max_image_size = 160;
+    const size_t sprite_count = 20000;
+    const size_t frames = 20;
+
+    template<typename Submit>
+    void measure(const char* name, Renderer::RenderQueue& queue, Renderer::SpriteBatch& batch, Submit submit){
+        size_t draw_calls = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < frames; ++frame){
+            submit();
+            batch.begin();
+            queue.flush(batch);
+            batch.end();
+            draw_calls += batch.draw_calls();
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        std::cout << "  " << name << ": " << static_cast<double>(draw_calls) / frames << " draws/frame, "
+                  << std::chrono::duration<double, std::milli>(finish - start).count() / frames << " ms/frame" << std::endl;
+    }
+}
+
+int main(){
+    NullGL::load();
+
+    std::mt19937 random(11);
+    const std::vector<unsigned char> pixels(max_image_size * max_image_size * 4, 255);
+    std::vector<std::unique_ptr<Renderer::Texture2D>> loose_images;
+    std::vector<Renderer::DynamicAtlas::Region> regions;
+    Renderer::DynamicAtlas atlas;
+    double pack_ms = 0.0;
+    for (size_t i = 0; i < image_count; ++i){
+        const unsigned int width = min_image_size + random() % (max_image_size - min_image_size + 1);
+        const unsigned int height = min_image_size + random() % (max_image_size - min_image_size + 1);
+        loose_images.emplace_back(std::make_unique<Renderer::Texture2D>(width, height, pixels.data(), 4, GL_NEAREST));
+        const auto start = std::chrono::steady_clock::now();
+        regions.push_back(atlas.add("image_" + std::to_string(i), width, height, pixels.data()));
+        pack_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    const Renderer::DynamicAtlas::Stats stats = atlas.stats();
+    std::cout << image_count << " images of " << min_image_size << ".." << max_image_size << " px packed into "
+              << atlas.page_count() << " pages in " << pack_ms << " ms, efficiency " << stats.efficiency() * 100.0
+              << "% of the covered area, " << 100.0 * stats.image_area / stats.page_area << "% of the page area" << std::endl;
+
+    const Renderer::ShaderProgram shader_program("", "");
+    auto quad_geometry = std::make_shared<Renderer::QuadGeometry>();
+    Renderer::SpriteBatch batch(quad_geometry, Renderer::SpriteBatch::Mode::Instanced);
+    Renderer::RenderQueue queue;
+
+    std::vector<size_t> sprite_images(sprite_count);
+    std::vector<Renderer::SpriteInstance> instances(sprite_count);
+    for (size_t i = 0; i < sprite_count; ++i){
+        sprite_images[i] = random() % image_count;
+        instances[i] = Renderer::SpriteInstance{glm::vec2(random() % 1270, random() % 720), glm::vec2(32.0f), 0.0f,
+                                                static_cast<float>(random() % 100), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), 0.0f};
+    }
+
+    std::cout << sprite_count << " sprites" << std::endl;
+    measure("Texture2D per image", queue, batch, [&](){
+        for (size_t i = 0; i < sprite_count; ++i){
+            queue.submit(loose_images[sprite_images[i]].get(), &shader_program, instances[i]);
+        }
+    });
+    measure("DynamicAtlas pages ", queue, batch, [&](){
+        for (size_t i = 0; i < sprite_count; ++i){
+            const Renderer::DynamicAtlas::Region& region = regions[sprite_images[i]];
+            Renderer::SpriteInstance instance = instances[i];
+            instance.uv_rect = glm::vec4(region.tile.left_bottom_uv, region.tile.right_top_uv);
+            queue.submit(region.p_page.get(), &shader_program, instance);
+        }
+    });
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/resources/mapped_file.hpp"
+
+// Writes an asset directory (a few large sheets and many small shader-sized
+// files) to the temp directory and reads it back the way get_file_path used
+// to (fstream -> stringstream -> str()) and through MappedFile. The copy count
+// isn't measured: it is what each path does by construction, every file into
+// the stringbuf and once more out of it for the old path, none for MappedFile.
+
+namespace{
+    const size_t large_file_count = 32;
+    const size_t large_file_size = 4 * 1024 * 1024;
+    const size_t small_file_count = 1024;
+    const size_t small_file_size = 4 * 1024;
+    const size_t passes = 5;
+    volatile size_t sink = 0;
+
+    std::vector<std::string> write_assets(const std::filesystem::path& directory){
+        std::filesystem::create_directories(directory);
+        std::vector<std::string> paths;
+        std::string content;
+        for (size_t i = 0; i < large_file_count + small_file_count; ++i){
+            content.resize(i < large_file_count ? large_file_size : small_file_size);
+            for (size_t j = 0; j < content.size(); ++j){
+                content[j] = static_cast<char>('a' + (i + j) % 26);
+            }
+            paths.push_back((directory / ("asset_" + std::to_string(i) + ".bin")).string());
+            std::ofstream(paths.back(), std::ios::binary).write(content.data(), content.size());
+        }
+        return paths;
+    }
+
+    // touches every byte so both paths actually read the data
+    size_t checksum(const char* p_data, const size_t size){
+        size_t sum = 0;
+        for (size_t i = 0; i < size; i += 64){
+            sum += static_cast<unsigned char>(p_data[i]);
+        }
+        return sum;
+    }
+
+    template<typename Read>
+    void measure(const char* name, const std::vector<std::string>& paths, Read read){
+        size_t bytes = 0;
+        size_t bytes_copied = 0;
+        size_t sum = 0;
+        read(paths.front(), bytes, bytes_copied, sum);
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t pass = 0; pass < passes; ++pass){
+            bytes = 0;
+            bytes_copied = 0;
+            for (const std::string& path : paths){
+                read(path, bytes, bytes_copied, sum);
+            }
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(finish - start).count() / passes;
+        std::cout << "  " << name << ": " << ms << " ms, "
+                  << bytes / (1024 * 1024) << " MiB read, "
+                  << bytes_copied / (1024 * 1024) << " MiB copied by design" << std::endl;
+        sink = sum;
+    }
+}
+
+int main(){
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "practice_file_read_bench";
+    const std::vector<std::string> paths = write_assets(directory);
+    std::cout << paths.size() << " files (" << large_file_count << " x " << large_file_size / 1024 << " KiB, "
+              << small_file_count << " x " << small_file_size / 1024 << " KiB), warm page cache" << std::endl;
+
+    measure("fstream + stringstream", paths, [](const std::string& path, size_t& bytes, size_t& bytes_copied, size_t& sum){
+        std::fstream file;
+        file.open(path, std::ios::in | std::ios::binary);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const std::string content = buffer.str();
+        bytes += content.size();
+        bytes_copied += 2 * content.size();
+        sum += checksum(content.data(), content.size());
+    });
+
+    measure("MappedFile            ", paths, [](const std::string& path, size_t& bytes, size_t&, size_t& sum){
+        const MappedFile file(path);
+        bytes += file.size();
+        sum += checksum(file.view().data(), file.size());
+    });
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
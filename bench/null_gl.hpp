@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <glad/glad.h>
+
+// Loads every GL entry point with a stub that does nothing but count calls, so
+// benchmarks can construct renderer objects without a context. Stubs return 0
+// and never write through output pointers, except glGetIntegerv (writes 0) and
+// the glGen* / glCreate* object functions, which hand out increasing names. Buffer
+// mapping returns zeroed host memory that lives until the process exits, and shader
+// and program status queries report success so ShaderProgram can be built.
+// glDraw* calls are also counted on their own in draw_calls.
+namespace NullGL{
+    inline size_t calls = 0;
+
+    inline void* call(){
+        ++calls;
+        return nullptr;
+    }
+
+    inline size_t draw_calls = 0;
+
+    inline void* draw(){
+        ++calls;
+        ++draw_calls;
+        return nullptr;
+    }
+
+    inline const GLubyte* APIENTRY get_string(GLenum){
+        ++calls;
+        return reinterpret_cast<const GLubyte*>("4.6.0 NullGL");
+    }
+
+    inline void APIENTRY get_integerv(GLenum, GLint* data){
+        ++calls;
+        *data = 0;
+    }
+
+    inline GLuint last_name = 0;
+
+    inline void APIENTRY gen_names(GLsizei count, GLuint* names){
+        ++calls;
+        for (GLsizei i = 0; i < count; ++i){
+            names[i] = ++last_name;
+        }
+    }
+
+    inline void APIENTRY create_textures(GLenum, GLsizei count, GLuint* names){
+        gen_names(count, names);
+    }
+
+    inline void APIENTRY get_object_iv(GLuint, GLenum, GLint* params){
+        ++calls;
+        *params = 1;
+    }
+
+    inline void APIENTRY get_program_interface_iv(GLuint, GLenum, GLenum, GLint* params){
+        ++calls;
+        *params = 0;
+    }
+
+    inline std::vector<std::unique_ptr<unsigned char[]>> mappings;
+
+    inline void* APIENTRY map_buffer_range(GLenum, GLintptr, GLsizeiptr length, GLbitfield){
+        ++calls;
+        mappings.emplace_back(new unsigned char[length]());
+        return mappings.back().get();
+    }
+
+    inline void* load_proc(const char* name){
+        if (std::strcmp(name, "glGetString") == 0){
+            return reinterpret_cast<void*>(&get_string);
+        }
+        if (std::strcmp(name, "glGetIntegerv") == 0){
+            return reinterpret_cast<void*>(&get_integerv);
+        }
+        if (std::strcmp(name, "glMapBufferRange") == 0 || std::strcmp(name, "glMapNamedBufferRange") == 0){
+            return reinterpret_cast<void*>(&map_buffer_range);
+        }
+        if (std::strcmp(name, "glGetShaderiv") == 0 || std::strcmp(name, "glGetProgramiv") == 0){
+            return reinterpret_cast<void*>(&get_object_iv);
+        }
+        if (std::strcmp(name, "glGetProgramInterfaceiv") == 0){
+            return reinterpret_cast<void*>(&get_program_interface_iv);
+        }
+        if (std::strcmp(name, "glCreateTextures") == 0){
+            return reinterpret_cast<void*>(&create_textures);
+        }
+        if (std::strcmp(name, "glGenTextures") == 0 || std::strcmp(name, "glGenBuffers") == 0 ||
+            std::strcmp(name, "glGenVertexArrays") == 0 || std::strcmp(name, "glCreateBuffers") == 0 ||
+            std::strcmp(name, "glCreateVertexArrays") == 0){
+            return reinterpret_cast<void*>(&gen_names);
+        }
+        if (std::strncmp(name, "glDraw", 6) == 0){
+            return reinterpret_cast<void*>(&draw);
+        }
+        return reinterpret_cast<void*>(&call);
+    }
+
+    inline void load(){
+        gladLoadGLLoader(&load_proc);
+        calls = 0;
+        draw_calls = 0;
+    }
+}
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/renderer/texture_2d.hpp"
+#include "../src/resources/name_table.hpp"
+#include "../src/resources/resource_handle.hpp"
+#include "null_gl.hpp"
+
+// Resolving textures by name the way ResourcesManager used to (std::map keyed
+// by string, returning a shared_ptr copy) against the NameTable probe by a
+// ResourceName hashed at runtime or ahead of time (as a constexpr name is),
+// and against a ResourceRegistry handle (index + generation check, raw pointer).
+
+namespace{
+    const size_t texture_count = 1000;
+    const size_t lookups = 2000000;
+
+    template<typename Lookup>
+    void measure(const char* name, Lookup lookup){
+        const auto start = std::chrono::steady_clock::now();
+        const size_t checksum = lookup();
+        const auto finish = std::chrono::steady_clock::now();
+        std::cout << "  " << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / lookups
+                  << " ns/lookup (checksum " << checksum << ")" << std::endl;
+    }
+}
+
+int main(){
+    NullGL::load();
+
+    std::map<const std::string, std::shared_ptr<Renderer::Texture2D>> textures_by_name;
+    NameTable names;
+    ResourceRegistry<Renderer::Texture2D> textures;
+    std::vector<std::string> texture_names;
+    for (size_t i = 0; i < texture_count; ++i){
+        texture_names.push_back("textures/characters/sprite_sheet_" + std::to_string(i));
+        auto p_texture = std::make_shared<Renderer::Texture2D>(1, 1, nullptr);
+        textures_by_name.emplace(texture_names.back(), p_texture);
+        textures.add(names.intern(texture_names.back()), p_texture);
+    }
+
+    std::mt19937 random(5);
+    std::vector<size_t> order(lookups);
+    for (size_t& index : order){
+        index = random() % texture_count;
+    }
+    std::vector<ResourceName> resource_names;
+    std::vector<TextureHandle> handles;
+    for (const std::string& name : texture_names){
+        resource_names.emplace_back(name);
+        handles.push_back(textures.find(names.find(name)));
+    }
+
+    std::cout << lookups << " lookups over " << texture_count << " textures" << std::endl;
+    measure("std::map<std::string>  ", [&](){
+        size_t checksum = 0;
+        for (const size_t index : order){
+            const std::shared_ptr<Renderer::Texture2D> p_texture = textures_by_name.find(texture_names[index])->second;
+            checksum += p_texture->id();
+        }
+        return checksum;
+    });
+    measure("string -> NameId handle", [&](){
+        size_t checksum = 0;
+        for (const size_t index : order){
+            checksum += textures.get(textures.find(names.find(texture_names[index])))->id();
+        }
+        return checksum;
+    });
+    measure("ResourceName -> handle ", [&](){
+        size_t checksum = 0;
+        for (const size_t index : order){
+            checksum += textures.get(textures.find(names.find(resource_names[index])))->id();
+        }
+        return checksum;
+    });
+    measure("TextureHandle          ", [&](){
+        size_t checksum = 0;
+        for (const size_t index : order){
+            checksum += textures.get(handles[index])->id();
+        }
+        return checksum;
+    });
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "../src/renderer/quad_geometry.hpp"
+#include "../src/renderer/shader.hpp"
+#include "../src/renderer/sprite.hpp"
+#include "../src/renderer/sprite_batch.hpp"
+#include "../src/renderer/texture_2d.hpp"
+#include "null_gl.hpp"
+
+// Compares the CPU cost per frame of Sprite::render (one model matrix and one
+// draw per sprite) with Sprite::submit into a SpriteBatch in both modes (one
+// draw per texture run, plus capacity flushes and stream buffer region
+// switches). GL calls go to the NullGL stubs, so the times are the renderer's
+// own CPU work without the driver; draws are counted at the stubs.
+
+namespace{
+    const size_t sprite_count = 100000;
+    const size_t texture_count = 4;
+    const size_t frames = 20;
+
+    struct Result{
+        double ms = 0.0;
+        size_t draw_calls = 0;
+        size_t gl_calls = 0;
+    };
+
+    template<typename Frame>
+    Result measure(Frame frame){
+        frame();
+        const size_t draw_calls = NullGL::draw_calls;
+        const size_t gl_calls = NullGL::calls;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames; ++i){
+            frame();
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        Result result;
+        result.ms = std::chrono::duration<double, std::milli>(finish - start).count() / frames;
+        result.draw_calls = (NullGL::draw_calls - draw_calls) / frames;
+        result.gl_calls = (NullGL::calls - gl_calls) / frames;
+        return result;
+    }
+
+    void report(const char* name, const Result& result){
+        std::cout << "  " << name << ": " << result.ms << " ms/frame, "
+                  << result.draw_calls << " draws, " << result.gl_calls << " GL calls" << std::endl;
+    }
+}
+
+int main(){
+    NullGL::load();
+
+    const unsigned char pixels[4 * 4 * 4] = {};
+    std::vector<std::shared_ptr<Renderer::Texture2D>> textures;
+    for (size_t i = 0; i < texture_count; ++i){
+        textures.emplace_back(std::make_shared<Renderer::Texture2D>(4, 4, pixels, 4, GL_NEAREST));
+        textures.back()->add_tile("sprite", glm::vec2(0.0f), glm::vec2(1.0f));
+    }
+    const auto shader_program = std::make_shared<Renderer::ShaderProgram>("", "");
+    const auto quad_geometry = std::make_shared<Renderer::QuadGeometry>();
+    Renderer::SpriteBatch vertices_batch(quad_geometry, Renderer::SpriteBatch::Mode::Vertices);
+    Renderer::SpriteBatch instanced_batch(quad_geometry, Renderer::SpriteBatch::Mode::Instanced);
+
+    for (const size_t sprite_run : {size_t(1), size_t(64), sprite_count}){
+        std::vector<std::unique_ptr<Renderer::Sprite>> sprites;
+        sprites.reserve(sprite_count);
+        for (size_t i = 0; i < sprite_count; ++i){
+            const glm::vec2 position(static_cast<float>(i % 1270), static_cast<float>(i % 720));
+            const float rotation = (i % 8 == 0) ? static_cast<float>(i % 360) : 0.0f;
+            sprites.emplace_back(std::make_unique<Renderer::Sprite>(textures[(i / sprite_run) % texture_count], "sprite",
+                                                                    shader_program, quad_geometry, position, glm::vec2(32.0f), rotation));
+        }
+        std::cout << sprite_count << " sprites, " << texture_count << " textures, runs of " << sprite_run << std::endl;
+
+        report("Sprite::render         ", measure([&](){
+            for (const auto& sprite : sprites){
+                sprite->render();
+            }
+        }));
+
+        for (Renderer::SpriteBatch* p_batch : {&vertices_batch, &instanced_batch}){
+            const bool is_instanced = p_batch == &instanced_batch;
+            report(is_instanced ? "SpriteBatch, instanced " : "SpriteBatch, vertices  ", measure([&](){
+                p_batch->begin();
+                for (const auto& sprite : sprites){
+                    sprite->submit(*p_batch);
+                }
+                p_batch->end();
+            }));
+        }
+    }
+    return 0;
+}
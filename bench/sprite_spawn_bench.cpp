@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "null_gl.hpp"
+#include "../src/renderer/quad_geometry.hpp"
+#include "../src/renderer/sprite.hpp"
+#include "../src/renderer/texture_2d.hpp"
+
+// Spawn rate of Sprite objects, with the GL calls and heap allocations each
+// spawn costs. Sprites share one QuadGeometry, so spawning should issue no GL
+// calls. Also the cost of switching the tile of an existing sprite instead.
+
+namespace{
+    size_t allocations = 0;
+}
+
+void* operator new(size_t size){
+    ++allocations;
+    if (void* p = std::malloc(size)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept{
+    std::free(p);
+}
+
+int main(){
+    NullGL::load();
+
+    const unsigned char pixels[4 * 4 * 4] = {};
+    auto texture = std::make_shared<Renderer::Texture2D>(4, 4, pixels, 4, GL_NEAREST, GL_CLAMP_TO_EDGE);
+    texture->add_tile("grass", glm::vec2(0.0f), glm::vec2(0.5f));
+    const Renderer::TileId tile_ids[2] = {texture->add_tile("sand", glm::vec2(0.5f), glm::vec2(1.0f)), texture->find_tile("grass")};
+    const std::shared_ptr<Renderer::ShaderProgram> shader;
+    auto quad_geometry = std::make_shared<Renderer::QuadGeometry>();
+
+    const std::string tile_name = "grass";
+    const size_t sprite_count = 100000;
+
+    {
+        std::vector<std::shared_ptr<Renderer::Sprite>> sprites;
+        sprites.reserve(sprite_count);
+        const size_t gl_calls = NullGL::calls;
+        const size_t heap_allocations = allocations;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < sprite_count; ++i){
+            sprites.emplace_back(std::make_shared<Renderer::Sprite>(texture, tile_name, shader, quad_geometry,
+                                                                    glm::vec2(static_cast<float>(i), 0.0f), glm::vec2(32.0f)));
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(finish - start).count();
+        std::cout << "make_shared<Sprite>: " << sprite_count / ms * 1000.0 << " sprites/s, "
+                  << static_cast<double>(NullGL::calls - gl_calls) / sprite_count << " GL calls/sprite, "
+                  << static_cast<double>(allocations - heap_allocations) / sprite_count << " allocations/sprite" << std::endl;
+    }
+
+    {
+        // placement into preallocated storage, i.e. the cost of the constructor alone
+        std::unique_ptr<unsigned char[]> storage(new unsigned char[sprite_count * sizeof(Renderer::Sprite) + alignof(Renderer::Sprite)]);
+        void* aligned = storage.get();
+        size_t space = sprite_count * sizeof(Renderer::Sprite) + alignof(Renderer::Sprite);
+        auto* sprites = static_cast<Renderer::Sprite*>(std::align(alignof(Renderer::Sprite), sprite_count * sizeof(Renderer::Sprite), aligned, space));
+
+        const size_t gl_calls = NullGL::calls;
+        const size_t heap_allocations = allocations;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < sprite_count; ++i){
+            new (&sprites[i]) Renderer::Sprite(texture, tile_name, shader, quad_geometry,
+                                               glm::vec2(static_cast<float>(i), 0.0f), glm::vec2(32.0f));
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(finish - start).count();
+        std::cout << "Sprite constructor:  " << sprite_count / ms * 1000.0 << " sprites/s, "
+                  << static_cast<double>(NullGL::calls - gl_calls) / sprite_count << " GL calls/sprite, "
+                  << static_cast<double>(allocations - heap_allocations) / sprite_count << " allocations/sprite" << std::endl;
+
+        const size_t tile_gl_calls = NullGL::calls;
+        const size_t tile_heap_allocations = allocations;
+        const auto tile_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < sprite_count; ++i){
+            sprites[i].set_tile(tile_ids[i & 1]);
+        }
+        const auto tile_finish = std::chrono::steady_clock::now();
+        const double tile_ms = std::chrono::duration<double, std::milli>(tile_finish - tile_start).count();
+        std::cout << "Sprite::set_tile:    " << sprite_count / tile_ms * 1000.0 << " sprites/s, "
+                  << static_cast<double>(NullGL::calls - tile_gl_calls) / sprite_count << " GL calls/sprite, "
+                  << static_cast<double>(allocations - tile_heap_allocations) / sprite_count << " allocations/sprite" << std::endl;
+
+        for (size_t i = 0; i < sprite_count; ++i){
+            sprites[i].~Sprite();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "null_gl.hpp"
+#include "../src/renderer/quad_geometry.hpp"
+#include "../src/renderer/sprite.hpp"
+#include "../src/renderer/texture_2d.hpp"
+
+// Cost of producing model matrices for 100k sprites per frame, rebuilt from
+// scratch as Sprite::render used to versus the cached Sprite::model_matrix,
+// for static and moving sprites with and without rotation.
+
+namespace{
+    const size_t sprite_count = 100000;
+    const size_t frames = 50;
+    volatile float sink = 0.0f;
+
+    // rebuilds the matrix from the sprite's own fields, as Sprite::render did before caching
+    class BenchSprite : public Renderer::Sprite{
+    public:
+        using Sprite::Sprite;
+
+        glm::mat4 rebuild_model_matrix() const{
+            glm::mat4 model(1.0f);
+            model = glm::translate(model, glm::vec3(m_position, 0.0f));
+            model = glm::translate(model, glm::vec3(0.5f * m_size.x, -0.5f * m_size.y, 0.0f));
+            model = glm::rotate(model, glm::radians(m_rotation), glm::vec3(0.0f, 0.0f, 1.0f));
+            model = glm::translate(model, glm::vec3(-0.5f * m_size.x, 0.5f * m_size.y, 0.0f));
+            model = glm::scale(model, glm::vec3(m_size, 1.0f));
+            return model;
+        }
+    };
+
+    template<typename Frame>
+    void measure(const char* name, Frame frame){
+        frame();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames; ++i){
+            frame();
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(finish - start).count() / frames;
+        std::cout << name << ": " << ms << " ms per " << sprite_count << " sprites" << std::endl;
+    }
+}
+
+int main(){
+    NullGL::load();
+
+    const unsigned char pixels[4 * 4 * 4] = {};
+    auto texture = std::make_shared<Renderer::Texture2D>(4, 4, pixels, 4, GL_NEAREST, GL_CLAMP_TO_EDGE);
+    auto quad_geometry = std::make_shared<Renderer::QuadGeometry>();
+
+    std::vector<std::unique_ptr<BenchSprite>> sprites;
+    sprites.reserve(sprite_count);
+    for (size_t i = 0; i < sprite_count; ++i){
+        sprites.emplace_back(std::make_unique<BenchSprite>(texture, "default", nullptr, quad_geometry,
+                                                                glm::vec2(static_cast<float>(i % 1270), static_cast<float>(i % 720)),
+                                                                glm::vec2(32.0f)));
+    }
+
+    float x = 0.0f;
+    for (const float rotation : {0.0f, 45.0f}){
+        for (const auto& sprite : sprites){
+            sprite->set_rotation(rotation);
+        }
+        std::cout << "rotation " << rotation << std::endl;
+
+        measure("  static, rebuilt every frame", [&](){
+            float sum = 0.0f;
+            for (const auto& sprite : sprites){
+                sum += sprite->rebuild_model_matrix()[3][0];
+            }
+            sink = sum;
+        });
+
+        measure("  static, cached             ", [&](){
+            float sum = 0.0f;
+            for (const auto& sprite : sprites){
+                sum += sprite->model_matrix()[3][0];
+            }
+            sink = sum;
+        });
+
+        measure("  moving, rebuilt every frame", [&](){
+            x += 1.0f;
+            float sum = 0.0f;
+            for (const auto& sprite : sprites){
+                sprite->set_position(glm::vec2(x, 0.0f));
+                sum += sprite->rebuild_model_matrix()[3][0];
+            }
+            sink = sum;
+        });
+
+        measure("  moving, cached             ", [&](){
+            x += 1.0f;
+            float sum = 0.0f;
+            for (const auto& sprite : sprites){
+                sprite->set_position(glm::vec2(x, 0.0f));
+                sum += sprite->model_matrix()[3][0];
+            }
+            sink = sum;
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../src/renderer/quad_geometry.hpp"
+#include "../src/renderer/render_queue.hpp"
+#include "../src/renderer/shader.hpp"
+#include "../src/renderer/sprite_batch.hpp"
+#include "../src/renderer/texture_2d.hpp"
+#include "../src/renderer/texture_array.hpp"
+#include "null_gl.hpp"
+
+// A scene drawing sprites from 32 sheets in random order, submitted through
+// the RenderQueue into a SpriteBatch: once with one Texture2D per sheet, once
+// with all sheets as layers of one TextureArray. Reports draws per frame and
+// the CPU time of queue + batch (GL calls are stubs).
+
+namespace{
+    const size_t sheet_count = 32;
+    const GLuint sheet_size = 256;
+    const size_t sprite_count = 20000;
+    const size_t frames = 20;
+
+    template<typename Submit>
+    void measure(const char* name, Renderer::RenderQueue& queue, Renderer::SpriteBatch& batch, Submit submit){
+        size_t draw_calls = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < frames; ++frame){
+            submit();
+            batch.begin();
+            queue.flush(batch);
+            batch.end();
+            draw_calls += batch.draw_calls();
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        std::cout << "  " << name << ": " << static_cast<double>(draw_calls) / frames << " draws/frame, "
+                  << std::chrono::duration<double, std::milli>(finish - start).count() / frames << " ms/frame" << std::endl;
+    }
+}
+
+int main(){
+    NullGL::load();
+
+    const std::vector<unsigned char> pixels(sheet_size * sheet_size * 4, 255);
+    std::vector<std::unique_ptr<Renderer::Texture2D>> sheets;
+    Renderer::TextureArray texture_array(sheet_size, sheet_size, sheet_count);
+    for (size_t i = 0; i < sheet_count; ++i){
+        sheets.emplace_back(std::make_unique<Renderer::Texture2D>(sheet_size, sheet_size, pixels.data(), 4, GL_NEAREST));
+        texture_array.set_layer(static_cast<GLuint>(i), sheet_size, sheet_size, pixels.data());
+    }
+    const Renderer::ShaderProgram shader_program("", "");
+    auto quad_geometry = std::make_shared<Renderer::QuadGeometry>();
+    Renderer::SpriteBatch batch(quad_geometry, Renderer::SpriteBatch::Mode::Instanced);
+    Renderer::RenderQueue queue;
+
+    std::mt19937 random(7);
+    std::vector<Renderer::SpriteInstance> instances(sprite_count);
+    for (Renderer::SpriteInstance& instance : instances){
+        instance = Renderer::SpriteInstance{glm::vec2(random() % 1270, random() % 720), glm::vec2(32.0f), 0.0f,
+                                            static_cast<float>(random() % 100), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+                                            static_cast<float>(random() % sheet_count)};
+    }
+
+    std::cout << sprite_count << " sprites from " << sheet_count << " sheets of " << sheet_size << "x" << sheet_size << std::endl;
+    measure("Texture2D per sheet", queue, batch, [&](){
+        for (const Renderer::SpriteInstance& instance : instances){
+            queue.submit(sheets[static_cast<size_t>(instance.texture_layer)].get(), &shader_program, instance);
+        }
+    });
+    measure("TextureArray       ", queue, batch, [&](){
+        for (const Renderer::SpriteInstance& instance : instances){
+            queue.submit(&texture_array, &shader_program, instance);
+        }
+    });
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../src/renderer/sprite_batch.hpp"
+#include "../src/renderer/transform_store.hpp"
+
+// Transform cost at 10k/100k/1M sprites: the glm math Sprite::render does per
+// object, SpriteBatch::write_quad over an array of instances, and the
+// TransformStore kernels (scalar and SIMD) writing vertices for the batch.
+
+namespace{
+    const size_t frames = 10;
+    volatile float sink = 0.0f;
+
+    template<typename Frame>
+    double measure_ms(Frame frame){
+        frame();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames; ++i){
+            frame();
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(finish - start).count() / frames;
+    }
+}
+
+int main(){
+#if defined(__AVX__)
+    std::cout << "SIMD kernel: AVX, 8 lanes" << std::endl;
+#elif defined(__SSE2__) || defined(_M_X64)
+    std::cout << "SIMD kernel: SSE2, 4 lanes" << std::endl;
+#else
+    std::cout << "SIMD kernel: not available, scalar fallback" << std::endl;
+#endif
+
+    for (const size_t sprite_count : {size_t(10000), size_t(100000), size_t(1000000)}){
+        std::vector<Renderer::SpriteInstance> instances(sprite_count);
+        Renderer::TransformStore transforms;
+        transforms.reserve(sprite_count);
+        for (size_t i = 0; i < sprite_count; ++i){
+            const glm::vec2 position(static_cast<float>(i % 1270), static_cast<float>(i % 720));
+            const glm::vec2 size(16.0f + i % 32, 16.0f + i % 16);
+            const float rotation = (i % 4 == 0) ? static_cast<float>(i % 360) : 0.0f;
+            instances[i] = Renderer::SpriteInstance{position, size, rotation, 0.0f, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), 0.0f};
+            transforms.add(position, size, rotation);
+        }
+        std::vector<Renderer::SpriteBatch::Vertex> vertices(sprite_count * 4);
+        std::vector<Renderer::SpriteBatch::Vertex> reference(sprite_count * 4);
+
+        const double matrix_ms = measure_ms([&](){
+            float sum = 0.0f;
+            for (const auto& instance : instances){
+                glm::mat4 model(1.0f);
+                model = glm::translate(model, glm::vec3(instance.position, 0.0f));
+                model = glm::translate(model, glm::vec3(0.5f * instance.size.x, -0.5f * instance.size.y, 0.0f));
+                model = glm::rotate(model, glm::radians(instance.rotation), glm::vec3(0.0f, 0.0f, 1.0f));
+                model = glm::translate(model, glm::vec3(-0.5f * instance.size.x, 0.5f * instance.size.y, 0.0f));
+                model = glm::scale(model, glm::vec3(instance.size, 1.0f));
+                sum += model[3][0];
+            }
+            sink = sum;
+        });
+
+        const double write_quad_ms = measure_ms([&](){
+            for (size_t i = 0; i < sprite_count; ++i){
+                Renderer::SpriteBatch::write_quad(&reference[i * 4], instances[i]);
+            }
+            sink = reference.back().position.x;
+        });
+
+        const double scalar_ms = measure_ms([&](){
+            transforms.write_quads_scalar(vertices.data(), 0, sprite_count);
+            sink = vertices.back().position.x;
+        });
+
+        const double simd_ms = measure_ms([&](){
+            transforms.write_quads(vertices.data(), 0, sprite_count);
+            sink = vertices.back().position.x;
+        });
+
+        float max_error = 0.0f;
+        for (size_t i = 0; i < vertices.size(); ++i){
+            max_error = std::max(max_error, std::abs(vertices[i].position.x - reference[i].position.x));
+            max_error = std::max(max_error, std::abs(vertices[i].position.y - reference[i].position.y));
+        }
+
+        std::cout << sprite_count << " sprites" << std::endl
+                  << "  Sprite::render matrices:       " << matrix_ms << " ms" << std::endl
+                  << "  SpriteBatch::write_quad:       " << write_quad_ms << " ms" << std::endl
+                  << "  TransformStore scalar:         " << scalar_ms << " ms" << std::endl
+                  << "  TransformStore SIMD:           " << simd_ms << " ms"
+                  << " (max error vs write_quad " << max_error << ")" << std::endl;
+    }
+    return 0;
+}
@@ -1,12 +1,12 @@
 #version 460
-layout(location = 0) in vec3 vertex_position;
-layout(location = 1) in vec2 vertex_uv;
+layout(location = 0) in vec2 vertex_position;
 out vec2 uv;
 
 uniform mat4 model_matrix;
 uniform mat4 projection_matrix;
+uniform vec4 uv_rect;
 
 void main(){
-    uv = vertex_uv;
-    gl_Position = projection_matrix * model_matrix * vec4(vertex_position, 1.0);
+    uv = mix(uv_rect.xy, uv_rect.zw, vertex_position);
+    gl_Position = projection_matrix * model_matrix * vec4(vertex_position, 0.0, 1.0);
 }
\ No newline at end of file
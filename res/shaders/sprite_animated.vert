@@ -0,0 +1,40 @@
+#version 460
+layout(location = 0) in vec2 vertex_position;
+layout(location = 1) in vec2 instance_position;
+layout(location = 2) in vec2 instance_size;
+layout(location = 3) in float instance_rotation;
+layout(location = 4) in float instance_layer;
+// first frame, frame count, frame duration, start time (AnimationFrameTable::instance_animation)
+layout(location = 5) in vec4 instance_animation;
+layout(location = 6) in float instance_texture_layer;
+out vec2 uv;
+flat out float texture_layer;
+
+layout(std430, binding = 0) readonly buffer AnimationFrames{
+    vec4 frame_uv_rects[];
+};
+
+uniform mat4 projection_matrix;
+uniform float time;
+
+void main(){
+    float elapsed = max(time - instance_animation.w, 0.0);
+    int frame = int(instance_animation.x) + int(mod(floor(elapsed / instance_animation.z), max(instance_animation.y, 1.0)));
+    vec4 uv_rect = frame_uv_rects[frame];
+    uv = mix(uv_rect.xy, uv_rect.zw, vertex_position);
+    texture_layer = instance_texture_layer;
+
+    // same transform as sprite_instanced.vert
+    float angle = radians(instance_rotation);
+    float c = cos(angle);
+    float s = sin(angle);
+    vec2 pivot = vec2(0.5, -0.5) * instance_size;
+    vec2 offset = instance_position + pivot - vec2(c * pivot.x - s * pivot.y, s * pivot.x + c * pivot.y);
+    mat4 model_matrix = mat4(
+        c * instance_size.x, s * instance_size.x, 0.0, 0.0,
+        -s * instance_size.y, c * instance_size.y, 0.0, 0.0,
+        0.0, 0.0, 1.0, 0.0,
+        offset.x, offset.y, instance_layer, 1.0);
+
+    gl_Position = projection_matrix * model_matrix * vec4(vertex_position, 0.0, 1.0);
+}
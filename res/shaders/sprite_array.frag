@@ -0,0 +1,10 @@
+#version 460
+in vec2 uv;
+flat in float texture_layer;
+out vec4 fragment_color;
+
+uniform sampler2DArray texture_0;
+
+void main(){
+    fragment_color = texture(texture_0, vec3(uv, texture_layer));
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#version 460
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec2 vertex_uv;
+layout(location = 2) in float vertex_texture_layer;
+out vec2 uv;
+flat out float texture_layer;
+
+uniform mat4 projection_matrix;
+
+void main(){
+    uv = vertex_uv;
+    texture_layer = vertex_texture_layer;
+    gl_Position = projection_matrix * vec4(vertex_position, 1.0);
+}
\ No newline at end of file
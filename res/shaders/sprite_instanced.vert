@@ -0,0 +1,31 @@
+#version 460
+layout(location = 0) in vec2 vertex_position;
+layout(location = 1) in vec2 instance_position;
+layout(location = 2) in vec2 instance_size;
+layout(location = 3) in float instance_rotation;
+layout(location = 4) in float instance_layer;
+layout(location = 5) in vec4 instance_uv_rect;
+layout(location = 6) in float instance_texture_layer;
+out vec2 uv;
+flat out float texture_layer;
+
+uniform mat4 projection_matrix;
+
+void main(){
+    uv = mix(instance_uv_rect.xy, instance_uv_rect.zw, vertex_position);
+    texture_layer = instance_texture_layer;
+
+    // same transform as Sprite::render: translate, rotate around (0.5 * w, -0.5 * h), scale
+    float angle = radians(instance_rotation);
+    float c = cos(angle);
+    float s = sin(angle);
+    vec2 pivot = vec2(0.5, -0.5) * instance_size;
+    vec2 offset = instance_position + pivot - vec2(c * pivot.x - s * pivot.y, s * pivot.x + c * pivot.y);
+    mat4 model_matrix = mat4(
+        c * instance_size.x, s * instance_size.x, 0.0, 0.0,
+        -s * instance_size.y, c * instance_size.y, 0.0, 0.0,
+        0.0, 0.0, 1.0, 0.0,
+        offset.x, offset.y, instance_layer, 1.0);
+
+    gl_Position = projection_matrix * model_matrix * vec4(vertex_position, 0.0, 1.0);
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <cstring>
+#include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -9,6 +11,12 @@
 #include "renderer/shader.hpp"
 #include "renderer/texture_2d.hpp"
 #include "renderer/sprite.hpp"
+#include "renderer/sprite_batch.hpp"
+#include "renderer/render_queue.hpp"
+#include "renderer/state_cache.hpp"
+#include "renderer/texture_uploader.hpp"
+#include "renderer/transform_store.hpp"
+#include "renderer/animation_frame_table.hpp"
 #include "resources/resources_manager.hpp"
 
 //   x     y     z
@@ -32,6 +40,14 @@ const GLfloat uv[] = {
 
 glm::vec2 window_size(1270, 720);
 
+// names looked up after loading, hashed at compile time
+constexpr ResourceName sprite_shader_name("sprite_shader");
+constexpr ResourceName sprite_batch_shader_name("sprite_batch_shader");
+constexpr ResourceName sprite_instanced_shader_name("sprite_instanced_shader");
+constexpr ResourceName default_tileset_name("default_tileset");
+constexpr ResourceName sara_sprite_name("sara_sprite");
+constexpr ResourceName grass_tile_name("grass");
+
 void glfwKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mode){
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS){
         glfwSetWindowShouldClose(window, GL_TRUE);
@@ -40,6 +56,19 @@ void glfwKeyCallback(GLFWwindow* window, int key, int scancode, int action, int
 
 int main(int argc, char** argv){
 
+    Renderer::SpriteBatch::Mode sprite_batch_mode = Renderer::SpriteBatch::Mode::Vertices;
+    bool print_telemetry = false;
+    const char* asset_pack_path = nullptr;
+    for (int i = 1; i < argc; ++i){
+        if (std::strcmp(argv[i], "--instanced") == 0){
+            sprite_batch_mode = Renderer::SpriteBatch::Mode::Instanced;
+        }else if (std::strcmp(argv[i], "--telemetry") == 0){
+            print_telemetry = true;
+        }else if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc){
+            asset_pack_path = argv[++i];
+        }
+    }
+
     /* Initialize the library */
     if (!glfwInit()){
         std::cout << "GLFW initialization failed." << std::endl;
@@ -79,6 +108,9 @@ int main(int argc, char** argv){
     glClearColor(0, 0, 0, 1);
     {
         ResourcesManager resources_manager(argv[0]);
+        if (asset_pack_path){
+            resources_manager.mount_pack(asset_pack_path);
+        }
         auto main_shader_program = resources_manager.load_shader("main_shader", "res/shaders/texture.vert", "res/shaders/texture.frag");
         if(!main_shader_program){
             std::cerr << "Can't create shader program: " << "main_shader" << std::endl;
@@ -91,15 +123,38 @@ int main(int argc, char** argv){
             return -1;
         }
 
+        auto sprite_batch_shader_program = resources_manager.load_shader("sprite_batch_shader", "res/shaders/sprite_batch.vert", "res/shaders/sprite.frag");
+        if(!sprite_batch_shader_program){
+            std::cerr << "Can't create shader program: " << "sprite_batch_shader" << std::endl;
+            return -1;
+        }
+
+        auto sprite_instanced_shader_program = resources_manager.load_shader("sprite_instanced_shader", "res/shaders/sprite_instanced.vert", "res/shaders/sprite.frag");
+        if(!sprite_instanced_shader_program){
+            std::cerr << "Can't create shader program: " << "sprite_instanced_shader" << std::endl;
+            return -1;
+        }
+
+        auto sprite_animated_shader_program = resources_manager.load_shader("sprite_animated_shader", "res/shaders/sprite_animated.vert", "res/shaders/sprite.frag");
+        if(!sprite_animated_shader_program){
+            std::cerr << "Can't create shader program: " << "sprite_animated_shader" << std::endl;
+            return -1;
+        }
+
+        const ResourceName batch_shader_name = sprite_batch_mode == Renderer::SpriteBatch::Mode::Instanced ? sprite_instanced_shader_name : sprite_batch_shader_name;
+
         auto tileset = resources_manager.load_texture("tileset", "res/textures/tileset.png");
-        auto sprite_texture = resources_manager.load_texture("sara_sprite", "res/textures/SaraFullSheet.png");
+        auto sprite_texture = resources_manager.load_texture_async("sara_sprite", "res/textures/SaraFullSheet.png");
 
-        std::vector<std::string> tiles_names = {"gray_bricks", "roof", "roof2", "planks", "grass"};
-        auto p_teleset = resources_manager.load_texture_atlas("default_tileset", "res/textures/tileset.png", std::move(tiles_names), 128, 128);
+        std::vector<Renderer::TileId> tileset_tiles;
+        auto p_teleset = resources_manager.load_texture_atlas("default_tileset", "res/textures/default_tileset.atlas", &tileset_tiles);
+        if (print_telemetry){
+            std::cout << "Aliased texture loads: " << resources_manager.aliased_texture_loads() << std::endl;
+        }
 
-        auto tile = resources_manager.load_sprite("tileset", "default_tileset", "sprite_shader", 256, 256, "grass");
+        auto tile = resources_manager.load_sprite("tileset", default_tileset_name, batch_shader_name, 256, 256, grass_tile_name);
 
-        auto sprite = resources_manager.load_sprite("sprite", "sara_sprite", "sprite_shader", 416 * 2, 672 * 2);
+        auto sprite = resources_manager.load_sprite("sprite", sara_sprite_name, sprite_shader_name, 416 * 2, 672 * 2);
 
         sprite->set_position(glm::vec2(300, 200));
         tile->set_position(glm::vec2(300, 200));
@@ -122,18 +177,94 @@ int main(int argc, char** argv){
 
         main_shader_program->set_matrix4("projection_matrix", projection_matrix);
         */
-        sprite_shader_program->use();
         sprite_shader_program->set_int("texture_0", 0);
         sprite_shader_program->set_matrix4("projection_matrix", projection_matrix);
 
+        sprite_batch_shader_program->set_int("texture_0", 0);
+        sprite_batch_shader_program->set_matrix4("projection_matrix", projection_matrix);
+
+        sprite_instanced_shader_program->set_int("texture_0", 0);
+        sprite_instanced_shader_program->set_matrix4("projection_matrix", projection_matrix);
+
+        sprite_animated_shader_program->set_int("texture_0", 0);
+        sprite_animated_shader_program->set_matrix4("projection_matrix", projection_matrix);
+        const Renderer::UniformId animation_time_id = sprite_animated_shader_program->uniform_id("time");
+
+        // a strip of tiles cycling through the tileset, animated by the shader alone
+        Renderer::AnimationFrameTable animation_frames;
+        Renderer::TransformStore ambient_sprites;
+        if (p_teleset && sprite_batch_mode == Renderer::SpriteBatch::Mode::Instanced){
+            const Renderer::AnimationFrameTable::Animation animation = animation_frames.add_animation(*p_teleset, tileset_tiles, 0.5f);
+            for (size_t i = 0; animation.frame_count > 0 && i < 16; ++i){
+                ambient_sprites.add(glm::vec2(64.0f * i, 64.0f), glm::vec2(64.0f), 0.0f,
+                                    Renderer::AnimationFrameTable::instance_animation(animation, 0.1f * i));
+            }
+        }
+
+        Renderer::SpriteBatch sprite_batch(resources_manager.get_quad_geometry(), sprite_batch_mode);
+        Renderer::RenderQueue render_queue;
+        render_queue.set_collect_stats(print_telemetry);
+
+        size_t telemetry_frames = 0;
+        size_t telemetry_draw_calls = 0;
+        size_t telemetry_switches_saved = 0;
+        double telemetry_start = glfwGetTime();
+        // the time uniform counts from here so it keeps float precision in long sessions
+        const double animation_start = glfwGetTime();
+        Renderer::StateCache::reset_counters();
+        bool is_upload_reported = false;
+
         /* Loop until the user closes the window */
         while (!glfwWindowShouldClose(window)){
 
+            resources_manager.process_uploads(2.0);
+            if (print_telemetry && !is_upload_reported && resources_manager.pending_texture_loads() == 0){
+                if (auto p_uploader = resources_manager.get_texture_uploader()){
+                    p_uploader->finish();
+                    const auto& stats = p_uploader->stats();
+                    std::cout << "texture uploads: " << stats.uploads
+                              << ", " << stats.bytes / (1024.0 * 1024.0) << " MB"
+                              << " at " << stats.megabytes_per_second() << " MB/s"
+                              << ", staging stalls " << stats.stalls << std::endl;
+                }
+                is_upload_reported = true;
+            }
+
             /* Render here */
             glClear(GL_COLOR_BUFFER_BIT);
 
-            tile->render();
-            //sprite->render();
+            tile->submit(render_queue);
+            //sprite->submit(render_queue);
+
+            sprite_batch.begin();
+            render_queue.flush(sprite_batch);
+            if (ambient_sprites.size() > 0){
+                sprite_animated_shader_program->set_float(animation_time_id, static_cast<float>(glfwGetTime() - animation_start));
+                animation_frames.bind();
+                sprite_batch.submit(p_teleset.get(), sprite_animated_shader_program.get(), ambient_sprites);
+            }
+            sprite_batch.end();
+
+            ++telemetry_frames;
+            telemetry_draw_calls += sprite_batch.draw_calls();
+            telemetry_switches_saved += render_queue.switches_saved();
+            if (print_telemetry && glfwGetTime() - telemetry_start >= 1.0){
+                const auto& counters = Renderer::StateCache::counters();
+                const double frames = static_cast<double>(telemetry_frames);
+                std::cout << "frames: " << telemetry_frames
+                          << " | per frame: draws " << telemetry_draw_calls / frames
+                          << ", programs " << counters.program_binds / frames
+                          << ", textures " << counters.texture_binds / frames
+                          << ", vaos " << counters.vertex_array_binds / frames
+                          << ", skipped " << counters.skipped_binds / frames
+                          << ", switches saved by sorting " << telemetry_switches_saved / frames
+                          << " | stream buffer stalls: " << sprite_batch.stream_stalls() << std::endl;
+                telemetry_frames = 0;
+                telemetry_draw_calls = 0;
+                telemetry_switches_saved = 0;
+                telemetry_start = glfwGetTime();
+                Renderer::StateCache::reset_counters();
+            }
 
             /* Swap front and back buffers */
             glfwSwapBuffers(window);
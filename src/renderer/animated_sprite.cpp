@@ -4,31 +4,76 @@
 
 namespace Renderer{
     AnimatedSprite::AnimatedSprite(const std::shared_ptr<Texture2D> p_texture,
-                                   const std::string initial_tile,
+                                   const ResourceName initial_tile,
                                    const std::shared_ptr<ShaderProgram> p_shader_program,
+                                   const std::shared_ptr<QuadGeometry> p_quad_geometry,
                                    const glm::vec2& position,
                                    const glm::vec2& size,
                                    const float rotation)
-                                   : Sprite(std::move(p_texture), std::move(initial_tile), std::move(p_shader_program), position, size, rotation){}
-        
-    void AnimatedSprite::insert_state(std::string state, std::vector<std::pair<std::string, uint64_t>> frame_duration){
-        m_states_map.emplace(std::move(state), std::move(frame_duration));
+                                   : Sprite(std::move(p_texture), initial_tile, std::move(p_shader_program), std::move(p_quad_geometry), position, size, rotation){}
+
+    void AnimatedSprite::insert_state(const std::string& state, const std::vector<std::pair<std::string, uint64_t>>& frame_duration){
+        std::vector<std::pair<TileId, uint64_t>> tile_durations;
+        tile_durations.reserve(frame_duration.size());
+        for (const auto& frame : frame_duration){
+            tile_durations.emplace_back(m_texture->find_tile(frame.first), frame.second);
+        }
+        insert_state(state, tile_durations);
     }
 
-    void AnimatedSprite::render() const{
-        
+    void AnimatedSprite::insert_state(const std::string& state, const std::vector<std::pair<TileId, uint64_t>>& frame_duration){
+        const size_t first_frame = m_frames.size();
+        uint64_t end_time = 0;
+        for (const auto& frame : frame_duration){
+            end_time += frame.second;
+            m_frames.push_back(Frame{m_texture->get_tile(frame.first), end_time});
+        }
+        add_state(state, first_frame);
     }
 
-    void AnimatedSprite::update(const size_t delta){
+    void AnimatedSprite::add_state(const std::string& state, const size_t first_frame){
+        const size_t frame_count = m_frames.size() - first_frame;
+        if (frame_count == 0){
+            std::cerr << "Animation state without frames: " << state << std::endl;
+            return;
+        }
+        auto result = m_state_ids.emplace(ResourceName::registered(state).value(), m_states.size());
+        if (!result.second){
+            std::cerr << "Animation state already exists: " << state << std::endl;
+            m_frames.resize(first_frame);
+            return;
+        }
+        m_states.push_back(State{first_frame, frame_count, m_frames.back().end_time});
+    }
 
+    void AnimatedSprite::update(const uint64_t delta){
+        if (m_current_state.duration == 0){
+            return;
+        }
+        m_current_animation_time += delta;
+        const size_t previous_frame = m_current_frame;
+        if (m_current_animation_time >= m_current_state.duration){
+            m_current_animation_time %= m_current_state.duration;
+            m_current_frame = 0;
+        }
+        const Frame* p_frames = &m_frames[m_current_state.first_frame];
+        while (m_current_animation_time >= p_frames[m_current_frame].end_time){
+            ++m_current_frame;
+        }
+        if (m_current_frame != previous_frame){
+            m_tile = p_frames[m_current_frame].tile;
+        }
     }
-    
-    void AnimatedSprite::set_state(const std::string& new_state){
-        auto it = m_states_map.find(new_state);
-        if (it != m_states_map.end()){
-            std::cout << "Animation state not foud: " << new_state << std::endl;
+
+    void AnimatedSprite::set_state(const ResourceName new_state){
+        auto it = m_state_ids.find(new_state.value());
+        if (it == m_state_ids.end()){
+            std::cerr << "Animation state not found: " << new_state.str() << std::endl;
+            return;
         }
+        m_current_state = m_states[it->second];
         m_current_animation_time = 0;
         m_current_frame = 0;
+        m_tile = m_frames[m_current_state.first_frame].tile;
     }
-}
\ No newline at end of file
+}
@@ -1,30 +1,59 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <glad/glad.h>
 #include <glm/vec2.hpp>
 
 #include "sprite.hpp"
+#include "tile_id.hpp"
 
 namespace Renderer{
+    // Sprite that cycles through the tiles of its texture. States are compiled
+    // once by insert_state into contiguous frames holding the tile and the
+    // time the frame ends at, so update only compares integers and render
+    // draws the current tile like any other sprite.
     class AnimatedSprite : public Sprite{
     public:
         AnimatedSprite(const std::shared_ptr<Texture2D> p_texture,
-               const std::string initial_tile,
+               const ResourceName initial_tile,
                const std::shared_ptr<ShaderProgram> p_shader_program,
+               const std::shared_ptr<QuadGeometry> p_quad_geometry,
                const glm::vec2& position = glm::vec2(0.0f),
                const glm::vec2& size = glm::vec2(1.0f),
                const float rotation = 0.0f);
-        
-        void insert_state(std::string state, std::vector<std::pair<std::string, uint64_t>> frame_duration);
-        void render() const override;
-        void update(const size_t delta);
-        void set_state(const std::string&  new_state);
+
+        // (tile, duration) pairs; durations are in the unit update is called with.
+        void insert_state(const std::string& state, const std::vector<std::pair<std::string, uint64_t>>& frame_duration);
+        void insert_state(const std::string& state, const std::vector<std::pair<TileId, uint64_t>>& frame_duration);
+        // Advances the current state, looping at its end.
+        void update(const uint64_t delta);
+        // Restarts from the first frame of the state.
+        void set_state(const ResourceName new_state);
+        size_t current_frame() const {return m_current_frame;}
 
     private:
-        std::map<std::string, std::vector<std::pair<std::string, size_t>>> m_states_map;
+        struct Frame{
+            Texture2D::Tile tile;
+            uint64_t end_time;  // sum of the durations up to and including this frame
+        };
+
+        struct State{
+            size_t first_frame;
+            size_t frame_count;
+            uint64_t duration;
+        };
+
+        void add_state(const std::string& state, const size_t first_frame);
+
+        std::vector<Frame> m_frames;  // frames of all states, each state contiguous
+        std::vector<State> m_states;
+        std::unordered_map<uint64_t, size_t> m_state_ids;  // by ResourceName
+        State m_current_state{0, 0, 0};
         size_t m_current_frame = 0;
         uint64_t m_current_animation_time = 0;
     };
@@ -0,0 +1,48 @@
+#include <iostream>
+
+#include "animation_frame_table.hpp"
+#include "texture_2d.hpp"
+
+namespace Renderer{
+    AnimationFrameTable::~AnimationFrameTable(){
+        glDeleteBuffers(1, &m_buffer);
+    }
+
+    AnimationFrameTable::Animation AnimationFrameTable::add_animation(const Texture2D& texture, const std::vector<TileId>& frames, const float frame_duration){
+        if (frames.empty()){
+            std::cerr << "ANIMATION FRAME TABLE: Animation has no frames" << std::endl;
+            return Animation{0, 0, 0.0f};
+        }
+        // the shader divides by it
+        if (!(frame_duration > 0.0f)){
+            std::cerr << "ANIMATION FRAME TABLE: Frame duration must be positive, got " << frame_duration << std::endl;
+            return Animation{0, 0, 0.0f};
+        }
+        const Animation animation{static_cast<uint32_t>(m_frames.size()), static_cast<uint32_t>(frames.size()), frame_duration};
+        for (const TileId frame : frames){
+            const Texture2D::Tile& tile = texture.get_tile(frame);
+            m_frames.emplace_back(tile.left_bottom_uv, tile.right_top_uv);
+        }
+        return animation;
+    }
+
+    AnimationFrameTable::Animation AnimationFrameTable::add_animation(const Texture2D& texture, const std::vector<std::string>& frames, const float frame_duration){
+        std::vector<TileId> tile_ids;
+        for (const std::string& frame : frames){
+            tile_ids.push_back(texture.find_tile(frame));
+        }
+        return add_animation(texture, tile_ids, frame_duration);
+    }
+
+    void AnimationFrameTable::bind(const GLuint binding){
+        // nothing to upload yet: zero-sized storage isn't allowed
+        if (m_uploaded_frames != m_frames.size() && !m_frames.empty()){
+            // immutable storage: the table is rebuilt whole when animations were added
+            glDeleteBuffers(1, &m_buffer);
+            glCreateBuffers(1, &m_buffer);
+            glNamedBufferStorage(m_buffer, m_frames.size() * sizeof(glm::vec4), m_frames.data(), 0);
+            m_uploaded_frames = m_frames.size();
+        }
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_buffer);
+    }
+}
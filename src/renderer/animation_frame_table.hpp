@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/vec4.hpp>
+
+#include "tile_id.hpp"
+
+namespace Renderer{
+    class Texture2D;
+
+    // UV rects of animation frames in a shader storage buffer, for sprites
+    // animated entirely on the GPU by sprite_animated.vert: each instance
+    // carries its animation in SpriteInstance::uv_rect (see instance_animation)
+    // and the shader picks the frame from the time uniform, so such sprites
+    // cost nothing on the CPU after they are spawned. Needs
+    // SpriteBatch::Mode::Instanced, the vertex mode expands UVs on the CPU.
+    class AnimationFrameTable{
+    public:
+        struct Animation{
+            uint32_t first_frame;
+            uint32_t frame_count;
+            float frame_duration;
+        };
+
+        AnimationFrameTable() = default;
+        ~AnimationFrameTable();
+        AnimationFrameTable(const AnimationFrameTable&) = delete;
+        AnimationFrameTable& operator=(const AnimationFrameTable&) = delete;
+
+        // Frames play frame_duration each, in the unit of the time uniform. An empty
+        // frame list or a duration that isn't positive is rejected with an empty
+        // Animation (frame_count 0), which must not be given to sprites.
+        Animation add_animation(const Texture2D& texture, const std::vector<TileId>& frames, const float frame_duration);
+        Animation add_animation(const Texture2D& texture, const std::vector<std::string>& frames, const float frame_duration);
+
+        // Value for SpriteInstance::uv_rect: the animation plays from start_time on.
+        static glm::vec4 instance_animation(const Animation& animation, const float start_time = 0.0f){
+            return glm::vec4(static_cast<float>(animation.first_frame), static_cast<float>(animation.frame_count), animation.frame_duration, start_time);
+        }
+
+        // Uploads the frames added since the last call, then binds the table to
+        // the shader storage binding point the shader reads it from.
+        void bind(const GLuint binding = 0);
+        size_t frame_count() const {return m_frames.size();}
+
+    private:
+        std::vector<glm::vec4> m_frames;
+        GLuint m_buffer = 0;
+        size_t m_uploaded_frames = 0;
+    };
+}
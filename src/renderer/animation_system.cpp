@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+
+#include "animation_system.hpp"
+#include "texture_2d.hpp"
+#include "../resources/thread_pool.hpp"
+
+namespace Renderer{
+    AnimationSystem::AnimationId AnimationSystem::add_animation(const Texture2D& texture, const std::vector<std::pair<std::string, uint64_t>>& frame_duration){
+        std::vector<std::pair<TileId, uint64_t>> tile_durations;
+        tile_durations.reserve(frame_duration.size());
+        for (const auto& frame : frame_duration){
+            tile_durations.emplace_back(texture.find_tile(frame.first), frame.second);
+        }
+        return add_animation(texture, tile_durations);
+    }
+
+    AnimationSystem::AnimationId AnimationSystem::add_animation(const Texture2D& texture, const std::vector<std::pair<TileId, uint64_t>>& frame_duration){
+        if (frame_duration.empty()){
+            std::cerr << "ANIMATION SYSTEM: Animation without frames" << std::endl;
+            return invalid_animation_id;
+        }
+        const Animation animation{static_cast<uint32_t>(m_frame_end_time.size()), static_cast<uint32_t>(frame_duration.size()), 0};
+        m_animations.push_back(animation);
+        uint64_t end_time = 0;
+        for (const auto& frame : frame_duration){
+            const Texture2D::Tile& tile = texture.get_tile(frame.first);
+            end_time += frame.second;
+            m_frame_end_time.push_back(end_time);
+            m_frame_uv_rect.emplace_back(tile.left_bottom_uv, tile.right_top_uv);
+        }
+        m_animations.back().duration = end_time;
+        return static_cast<AnimationId>(m_animations.size() - 1);
+    }
+
+    AnimationSystem::Index AnimationSystem::add(TransformStore& transforms, const TransformStore::Index sprite, const AnimationId animation, const uint64_t elapsed){
+        if (animation >= m_animations.size()){
+            std::cerr << "ANIMATION SYSTEM: Unknown animation " << animation << std::endl;
+            return invalid_index;
+        }
+        const Index index = static_cast<Index>(m_sprite.size());
+        m_sprite.push_back(sprite);
+        m_animation.push_back(animation);
+        m_frame.push_back(0);
+        m_frame_end.push_back(0);
+        seek(transforms.uv_rects(), index, elapsed);
+        return index;
+    }
+
+    void AnimationSystem::set_animation(TransformStore& transforms, const Index index, const AnimationId animation){
+        if (animation >= m_animations.size()){
+            std::cerr << "ANIMATION SYSTEM: Unknown animation " << animation << std::endl;
+            return;
+        }
+        m_animation[index] = animation;
+        seek(transforms.uv_rects(), index, 0);
+    }
+
+    void AnimationSystem::remove(const Index index){
+        m_sprite[index] = m_sprite.back();
+        m_animation[index] = m_animation.back();
+        m_frame[index] = m_frame.back();
+        m_frame_end[index] = m_frame_end.back();
+        m_sprite.pop_back();
+        m_animation.pop_back();
+        m_frame.pop_back();
+        m_frame_end.pop_back();
+    }
+
+    void AnimationSystem::clear(){
+        m_sprite.clear();
+        m_animation.clear();
+        m_frame.clear();
+        m_frame_end.clear();
+    }
+
+    void AnimationSystem::seek(glm::vec4* p_uv_rects, const Index index, const uint64_t elapsed){
+        const Animation& animation = m_animations[m_animation[index]];
+        if (animation.duration == 0){
+            // only zero-length frames: show the first one forever
+            m_frame[index] = 0;
+            m_frame_end[index] = UINT64_MAX;
+            p_uv_rects[m_sprite[index]] = m_frame_uv_rect[animation.first_frame];
+            return;
+        }
+        const uint64_t cycle_time = elapsed % animation.duration;
+        const uint64_t* p_end_times = &m_frame_end_time[animation.first_frame];
+        uint32_t frame = 0;
+        while (cycle_time >= p_end_times[frame]){
+            ++frame;
+        }
+        m_frame[index] = frame;
+        m_frame_end[index] = m_time - cycle_time + p_end_times[frame];
+        p_uv_rects[m_sprite[index]] = m_frame_uv_rect[animation.first_frame + frame];
+    }
+
+    size_t AnimationSystem::update_range(glm::vec4* p_uv_rects, const size_t first, const size_t last){
+        size_t changes = 0;
+        for (size_t i = first; i < last; ++i){
+            if (m_time < m_frame_end[i]){
+                continue;
+            }
+            const Animation& animation = m_animations[m_animation[i]];
+            const uint64_t* p_end_times = &m_frame_end_time[animation.first_frame];
+            uint32_t frame = m_frame[i];
+            // start of the current cycle on the system clock
+            uint64_t cycle_start = m_frame_end[i] - p_end_times[frame];
+            if (m_time - cycle_start >= animation.duration){
+                cycle_start = m_time - (m_time - cycle_start) % animation.duration;
+                frame = 0;
+            }
+            while (m_time >= cycle_start + p_end_times[frame]){
+                ++frame;
+            }
+            m_frame[i] = frame;
+            m_frame_end[i] = cycle_start + p_end_times[frame];
+            p_uv_rects[m_sprite[i]] = m_frame_uv_rect[animation.first_frame + frame];
+            ++changes;
+        }
+        return changes;
+    }
+
+    void AnimationSystem::update(const uint64_t delta, TransformStore& transforms, ThreadPool* p_thread_pool, const size_t min_sprites_per_job){
+        m_time += delta;
+        glm::vec4* p_uv_rects = transforms.uv_rects();
+        const size_t count = m_sprite.size();
+        size_t job_count = 1;
+        if (p_thread_pool && min_sprites_per_job > 0){
+            job_count = std::min(p_thread_pool->thread_count() + 1, count / min_sprites_per_job);
+        }
+        if (job_count <= 1){
+            m_frame_changes = update_range(p_uv_rects, 0, count);
+            return;
+        }
+
+        // jobs write disjoint sprites; the caller runs the first one and waits for the rest
+        const size_t job_size = (count + job_count - 1) / job_count;
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t pending_jobs = job_count - 1;
+        size_t changes = 0;
+        for (size_t job = 1; job < job_count; ++job){
+            const size_t first = job * job_size;
+            const size_t last = std::min(count, first + job_size);
+            p_thread_pool->enqueue([&, first, last](){
+                const size_t job_changes = update_range(p_uv_rects, first, last);
+                std::lock_guard<std::mutex> lock(mutex);
+                changes += job_changes;
+                if (--pending_jobs == 0){
+                    done.notify_one();
+                }
+            });
+        }
+        const size_t own_changes = update_range(p_uv_rects, 0, job_size);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&](){return pending_jobs == 0;});
+        m_frame_changes = changes + own_changes;
+    }
+}
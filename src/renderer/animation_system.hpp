@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+#include "tile_id.hpp"
+#include "transform_store.hpp"
+
+class ThreadPool;
+
+namespace Renderer{
+    class Texture2D;
+
+    // Steps every animated sprite of a TransformStore in one pass. Animations
+    // are compiled once into shared frame tables; the per-sprite state lives in
+    // parallel arrays. The system keeps one clock and each sprite the time its
+    // current frame ends, so a sprite whose frame doesn't change costs a single
+    // compare; on a change its UV rect is written straight into the store's
+    // uv_rect column, which SpriteBatch::submit copies into the instance data.
+    class AnimationSystem{
+    public:
+        typedef uint32_t AnimationId;
+        typedef uint32_t Index;
+        static const AnimationId invalid_animation_id = UINT32_MAX;
+        static const Index invalid_index = UINT32_MAX;
+
+        // Compiles the frames into a table shared by every sprite that plays the
+        // animation; durations use the unit of the deltas passed to update. An
+        // empty frame list is rejected with invalid_animation_id.
+        AnimationId add_animation(const Texture2D& texture, const std::vector<std::pair<std::string, uint64_t>>& frame_duration);
+        AnimationId add_animation(const Texture2D& texture, const std::vector<std::pair<TileId, uint64_t>>& frame_duration);
+
+        // Animates the UV rect of a sprite of the store, starting elapsed time into the
+        // animation; invalid_index for an unknown animation.
+        Index add(TransformStore& transforms, const TransformStore::Index sprite, const AnimationId animation, const uint64_t elapsed = 0);
+        // Restarts the sprite with another animation.
+        void set_animation(TransformStore& transforms, const Index index, const AnimationId animation);
+        // The last animated sprite takes over the removed index.
+        void remove(const Index index);
+        void clear();
+        size_t size() const {return m_sprite.size();}
+        size_t animation_count() const {return m_animations.size();}
+
+        // Advances the clock and every sprite. With a thread pool the sprites are
+        // split into jobs of at least min_sprites_per_job, the caller running one.
+        void update(const uint64_t delta, TransformStore& transforms,
+                    ThreadPool* p_thread_pool = nullptr, const size_t min_sprites_per_job = 16384);
+        // Frame changes written by the last update.
+        size_t frame_changes() const {return m_frame_changes;}
+
+    private:
+        struct Animation{
+            uint32_t first_frame;
+            uint32_t frame_count;
+            uint64_t duration;
+        };
+
+        // Puts the sprite on the frame elapsed time into its animation.
+        void seek(glm::vec4* p_uv_rects, const Index index, const uint64_t elapsed);
+        size_t update_range(glm::vec4* p_uv_rects, const size_t first, const size_t last);
+
+        std::vector<Animation> m_animations;
+        // frames of all animations, each animation contiguous
+        std::vector<uint64_t> m_frame_end_time;  // from the start of the animation
+        std::vector<glm::vec4> m_frame_uv_rect;
+
+        std::vector<TransformStore::Index> m_sprite;
+        std::vector<AnimationId> m_animation;
+        std::vector<uint32_t> m_frame;
+        std::vector<uint64_t> m_frame_end;  // on the system clock
+        uint64_t m_time = 0;
+        size_t m_frame_changes = 0;
+    };
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <iostream>
+
+#include "dynamic_atlas.hpp"
+
+namespace Renderer{
+    SkylinePacker::SkylinePacker(const unsigned int width, const unsigned int height)
+                                 : m_width(width), m_height(height){
+        m_skyline.push_back(Segment{0, 0, width});
+    }
+
+    bool SkylinePacker::fits(const size_t segment, const unsigned int width, const unsigned int height, unsigned int& y) const{
+        const unsigned int x = m_skyline[segment].x;
+        if (x + width > m_width){
+            return false;
+        }
+        // the rectangle rests on the highest segment it spans
+        y = 0;
+        unsigned int width_left = width;
+        for (size_t i = segment; width_left > 0; ++i){
+            y = std::max(y, m_skyline[i].y);
+            if (y + height > m_height){
+                return false;
+            }
+            width_left -= std::min(width_left, m_skyline[i].width);
+        }
+        return true;
+    }
+
+    bool SkylinePacker::insert(const unsigned int width, const unsigned int height, unsigned int& x, unsigned int& y){
+        size_t best_segment = m_skyline.size();
+        unsigned int best_y = m_height;
+        unsigned int best_width = 0;
+        for (size_t i = 0; i < m_skyline.size(); ++i){
+            unsigned int segment_y;
+            // lowest top edge wins, ties go to the narrowest segment
+            if (fits(i, width, height, segment_y) &&
+                (segment_y < best_y || (segment_y == best_y && m_skyline[i].width < best_width))){
+                best_segment = i;
+                best_y = segment_y;
+                best_width = m_skyline[i].width;
+            }
+        }
+        if (best_segment == m_skyline.size()){
+            return false;
+        }
+        x = m_skyline[best_segment].x;
+        y = best_y;
+
+        // raise the skyline under the rectangle, trimming the segments it covers
+        m_skyline.insert(m_skyline.begin() + best_segment, Segment{x, y + height, width});
+        for (size_t i = best_segment + 1; i < m_skyline.size();){
+            Segment& segment = m_skyline[i];
+            const unsigned int covered_until = x + width;
+            if (segment.x >= covered_until){
+                break;
+            }
+            const unsigned int overlap = covered_until - segment.x;
+            if (overlap >= segment.width){
+                m_skyline.erase(m_skyline.begin() + i);
+                continue;
+            }
+            segment.x += overlap;
+            segment.width -= overlap;
+            break;
+        }
+        for (size_t i = 0; i + 1 < m_skyline.size();){
+            if (m_skyline[i].y == m_skyline[i + 1].y){
+                m_skyline[i].width += m_skyline[i + 1].width;
+                m_skyline.erase(m_skyline.begin() + i + 1);
+            }else{
+                ++i;
+            }
+        }
+        return true;
+    }
+
+    size_t SkylinePacker::covered_area() const{
+        size_t area = 0;
+        for (const Segment& segment : m_skyline){
+            area += static_cast<size_t>(segment.y) * segment.width;
+        }
+        return area;
+    }
+
+    DynamicAtlas::DynamicAtlas(const unsigned int page_width, const unsigned int page_height, const unsigned int padding)
+                               : m_page_width(page_width), m_page_height(page_height), m_padding(padding){
+    }
+
+    DynamicAtlas::Region DynamicAtlas::add(const std::string& name, const unsigned int width, const unsigned int height,
+                                           const unsigned char* pixels, const unsigned int channels){
+        // padding on the right and top keeps neighbours from bleeding into each other under filtering
+        const unsigned int padded_width = width + m_padding;
+        const unsigned int padded_height = height + m_padding;
+        if (padded_width > m_page_width || padded_height > m_page_height){
+            std::cerr << "DYNAMIC ATLAS: " << name << " (" << width << "x" << height << ") is larger than a "
+                      << m_page_width << "x" << m_page_height << " page" << std::endl;
+            return Region{nullptr, Texture2D::Tile(), invalid_tile_id};
+        }
+
+        unsigned int x = 0;
+        unsigned int y = 0;
+        Page* p_page = nullptr;
+        for (Page& page : m_pages){
+            if (page.packer.insert(padded_width, padded_height, x, y)){
+                p_page = &page;
+                break;
+            }
+        }
+        if (!p_page){
+            m_pages.push_back(Page{std::make_shared<Texture2D>(m_page_width, m_page_height, nullptr, 4, GL_NEAREST, GL_CLAMP_TO_EDGE),
+                                   SkylinePacker(m_page_width, m_page_height)});
+            p_page = &m_pages.back();
+            p_page->packer.insert(padded_width, padded_height, x, y);
+        }
+
+        p_page->p_texture->set_pixels(x, y, width, height, pixels, channels);
+        const glm::vec2 page_size(m_page_width, m_page_height);
+        const Texture2D::Tile tile(glm::vec2(x, y) / page_size, glm::vec2(x + width, y + height) / page_size);
+        const TileId tile_id = p_page->p_texture->add_tile(name, tile.left_bottom_uv, tile.right_top_uv);
+        ++m_images;
+        m_image_area += static_cast<size_t>(width) * height;
+        return Region{p_page->p_texture, tile, tile_id};
+    }
+
+    DynamicAtlas::Stats DynamicAtlas::stats() const{
+        Stats stats;
+        stats.images = m_images;
+        stats.image_area = m_image_area;
+        for (const Page& page : m_pages){
+            stats.covered_area += page.packer.covered_area();
+            stats.page_area += static_cast<size_t>(m_page_width) * m_page_height;
+        }
+        return stats;
+    }
+}
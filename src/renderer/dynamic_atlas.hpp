@@ -0,0 +1,83 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "texture_2d.hpp"
+
+namespace Renderer{
+    // Skyline bottom-left rectangle allocator: keeps the top edge of the packed
+    // area as a list of horizontal segments and puts each rectangle where its
+    // bottom ends up lowest.
+    class SkylinePacker{
+    public:
+        SkylinePacker(const unsigned int width, const unsigned int height);
+
+        bool insert(const unsigned int width, const unsigned int height, unsigned int& x, unsigned int& y);
+        // Area below the skyline, i.e. used or wasted under packed rectangles.
+        size_t covered_area() const;
+
+    private:
+        struct Segment{
+            unsigned int x;
+            unsigned int y;
+            unsigned int width;
+        };
+
+        bool fits(const size_t segment, const unsigned int width, const unsigned int height, unsigned int& y) const;
+
+        unsigned int m_width;
+        unsigned int m_height;
+        std::vector<Segment> m_skyline;
+    };
+
+    // Packs loose images into shared RGBA pages at load time so sprites drawn
+    // from them batch together; a new page is added when an image fits nowhere.
+    // Every image becomes a tile of its page texture.
+    class DynamicAtlas{
+    public:
+        struct Region{
+            std::shared_ptr<Texture2D> p_page;
+            Texture2D::Tile tile;
+            TileId tile_id;
+            bool is_valid() const {return p_page != nullptr;}
+        };
+
+        struct Stats{
+            size_t images = 0;
+            size_t image_area = 0;    // pixels of the packed images
+            size_t covered_area = 0;  // pixels below the skylines of all pages
+            size_t page_area = 0;     // pixels of all pages
+            double efficiency() const {return covered_area ? static_cast<double>(image_area) / covered_area : 0.0;}
+        };
+
+        DynamicAtlas(const unsigned int page_width = 2048, const unsigned int page_height = 2048, const unsigned int padding = 1);
+        DynamicAtlas(const DynamicAtlas&) = delete;
+        DynamicAtlas& operator=(const DynamicAtlas&) = delete;
+
+        // Copies the image into a page and adds it there as a tile called name.
+        // Invalid if the image is larger than a page.
+        Region add(const std::string& name, const unsigned int width, const unsigned int height,
+                   const unsigned char* pixels, const unsigned int channels = 4);
+
+        size_t page_count() const {return m_pages.size();}
+        const std::shared_ptr<Texture2D>& page(const size_t index) const {return m_pages[index].p_texture;}
+        Stats stats() const;
+
+    private:
+        struct Page{
+            std::shared_ptr<Texture2D> p_texture;
+            SkylinePacker packer;
+        };
+
+        unsigned int m_page_width;
+        unsigned int m_page_height;
+        unsigned int m_padding;
+        std::vector<Page> m_pages;
+        size_t m_images = 0;
+        size_t m_image_area = 0;
+    };
+}
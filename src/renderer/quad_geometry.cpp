@@ -0,0 +1,36 @@
+#include "quad_geometry.hpp"
+#include "state_cache.hpp"
+
+namespace Renderer{
+    QuadGeometry::QuadGeometry(){
+        // 1   3
+        // | / |
+        // 0   2
+        //   x     y
+        const GLfloat vertices[] = {
+            0.0f, 0.0f,
+            0.0f, 1.0f,
+            1.0f, 0.0f,
+            1.0f, 1.0f
+        };
+
+        glCreateBuffers(1, &m_vertices_vbo);
+        glNamedBufferStorage(m_vertices_vbo, sizeof(vertices), &vertices, 0);
+
+        glCreateVertexArrays(1, &m_vao);
+        glVertexArrayVertexBuffer(m_vao, 0, m_vertices_vbo, 0, 2 * sizeof(GLfloat));
+        glEnableVertexArrayAttrib(m_vao, 0);
+        glVertexArrayAttribFormat(m_vao, 0, 2, GL_FLOAT, GL_FALSE, 0);
+        glVertexArrayAttribBinding(m_vao, 0, 0);
+    }
+
+    QuadGeometry::~QuadGeometry(){
+        glDeleteBuffers(1, &m_vertices_vbo);
+        StateCache::on_vertex_array_deleted(m_vao);
+        glDeleteVertexArrays(1, &m_vao);
+    }
+
+    void QuadGeometry::bind() const{
+        StateCache::bind_vertex_array(m_vao);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace Renderer{
+    // Unit quad shared by every sprite: four (x, y) corners in [0, 1] drawn as a
+    // triangle strip. Created once by ResourcesManager so sprites carry no GL objects.
+    class QuadGeometry{
+    public:
+        static constexpr GLsizei vertex_count = 4;
+
+        QuadGeometry();
+        ~QuadGeometry();
+        QuadGeometry(const QuadGeometry&) = delete;
+        QuadGeometry& operator=(const QuadGeometry&) = delete;
+
+        void bind() const;
+        GLuint vertices_vbo() const {return m_vertices_vbo;}
+
+    private:
+        GLuint m_vao = 0;
+        GLuint m_vertices_vbo = 0;
+    };
+}
@@ -0,0 +1,143 @@
+#include <cstring>
+
+#include "render_queue.hpp"
+#include "shader.hpp"
+#include "texture_2d.hpp"
+#include "texture_array.hpp"
+
+namespace Renderer{
+    RenderQueue::RenderQueue(){
+        std::memset(m_translucent, 0, sizeof(m_translucent));
+    }
+
+    void RenderQueue::set_translucent(const uint8_t layer, const bool translucent){
+        m_translucent[layer] = translucent;
+    }
+
+    uint64_t RenderQueue::make_key(const uint8_t layer,
+                                   const bool translucent,
+                                   const uint32_t shader_id,
+                                   const uint32_t texture_id,
+                                   const float depth){
+        // flip the float bits so unsigned comparison orders them like the floats
+        uint32_t depth_bits;
+        std::memcpy(&depth_bits, &depth, sizeof(depth_bits));
+        depth_bits = (depth_bits & 0x80000000u) ? ~depth_bits : (depth_bits | 0x80000000u);
+        const uint64_t depth_key = depth_bits >> 4;
+
+        uint64_t key = static_cast<uint64_t>(layer) << 56;
+        if (!translucent){
+            key |= static_cast<uint64_t>(shader_id & 0xFFFu) << 44;
+            key |= static_cast<uint64_t>(texture_id & 0xFFFFu) << 28;
+        }
+        return key | depth_key;
+    }
+
+    void RenderQueue::submit(const Texture2D* p_texture,
+                             const ShaderProgram* p_shader_program,
+                             const SpriteInstance& instance,
+                             const uint8_t layer){
+        add(p_texture->id(), p_shader_program, instance, layer);
+    }
+
+    void RenderQueue::submit(const TextureArray* p_texture_array,
+                             const ShaderProgram* p_shader_program,
+                             const SpriteInstance& instance,
+                             const uint8_t layer){
+        add(p_texture_array->id(), p_shader_program, instance, layer);
+    }
+
+    void RenderQueue::add(const GLuint texture_id,
+                          const ShaderProgram* p_shader_program,
+                          const SpriteInstance& instance,
+                          const uint8_t layer){
+        const uint64_t key = make_key(layer, m_translucent[layer],
+                                      p_shader_program ? p_shader_program->id() : 0,
+                                      texture_id,
+                                      instance.layer);
+        m_entries.push_back(SortEntry{key, static_cast<uint32_t>(m_items.size())});
+        m_items.push_back(Item{texture_id, p_shader_program, instance});
+        m_is_sorted = false;
+    }
+
+    void RenderQueue::sort(){
+        if (m_is_sorted){
+            return;
+        }
+        if (m_collect_stats){
+            m_stats.submitted = m_entries.size();
+            m_stats.switches_unsorted = count_switches(m_items, m_entries);
+        }
+
+        // LSD radix sort, 8 bits per pass; passes where every key has the same digit are skipped
+        m_scratch.resize(m_entries.size());
+        uint64_t differing_bits = 0;
+        for (const SortEntry& entry : m_entries){
+            differing_bits |= entry.key ^ m_entries.front().key;
+        }
+        for (unsigned shift = 0; shift < 64 && !m_entries.empty(); shift += 8){
+            if (((differing_bits >> shift) & 0xFFu) == 0){
+                continue;
+            }
+            size_t offsets[256] = {};
+            for (const SortEntry& entry : m_entries){
+                ++offsets[(entry.key >> shift) & 0xFFu];
+            }
+            size_t sum = 0;
+            for (size_t& offset : offsets){
+                const size_t count = offset;
+                offset = sum;
+                sum += count;
+            }
+            for (const SortEntry& entry : m_entries){
+                m_scratch[offsets[(entry.key >> shift) & 0xFFu]++] = entry;
+            }
+            m_entries.swap(m_scratch);
+        }
+
+        if (m_collect_stats){
+            m_stats.switches_sorted = count_switches(m_items, m_entries);
+        }
+        m_is_sorted = true;
+    }
+
+    void RenderQueue::flush(SpriteBatch& batch){
+        if (m_entries.empty()){
+            // an empty frame made no switches
+            m_stats = Stats();
+            return;
+        }
+        sort();
+        for (const SortEntry& entry : m_entries){
+            const Item& item = m_items[entry.item];
+            batch.submit_texture_id(item.texture_id, item.p_shader_program, item.instance);
+        }
+        clear_items();
+    }
+
+    void RenderQueue::clear(){
+        clear_items();
+        m_stats = Stats();
+    }
+
+    void RenderQueue::clear_items(){
+        m_items.clear();
+        m_entries.clear();
+        m_is_sorted = true;
+    }
+
+    size_t RenderQueue::count_switches(const std::vector<Item>& items, const std::vector<SortEntry>& order){
+        size_t switches = 0;
+        GLuint texture_id = 0;
+        const ShaderProgram* p_shader_program = nullptr;
+        for (const SortEntry& entry : order){
+            const Item& item = items[entry.item];
+            if (item.texture_id != texture_id || item.p_shader_program != p_shader_program){
+                texture_id = item.texture_id;
+                p_shader_program = item.p_shader_program;
+                ++switches;
+            }
+        }
+        return switches;
+    }
+}
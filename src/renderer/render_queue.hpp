@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "sprite_batch.hpp"
+
+namespace Renderer{
+    class Texture2D;
+    class TextureArray;
+    class ShaderProgram;
+
+    // Collects the sprites of a frame with a 64-bit sort key and radix-sorts them
+    // before they go to a SpriteBatch, so sprites sharing a shader and texture
+    // end up next to each other within a layer.
+    //
+    // key, opaque layer:      layer:8 | shader:12 | texture:16 | depth:28
+    // key, translucent layer: layer:8 | 0:28      | depth:28
+    // Translucent layers are ordered back to front and otherwise keep
+    // submission order (the sort is stable), so alpha blending stays correct.
+    class RenderQueue{
+    public:
+        struct Stats{
+            size_t submitted = 0;
+            size_t switches_unsorted = 0;
+            size_t switches_sorted = 0;
+        };
+
+        RenderQueue();
+
+        void set_translucent(const uint8_t layer, const bool translucent);
+        void submit(const Texture2D* p_texture,
+                    const ShaderProgram* p_shader_program,
+                    const SpriteInstance& instance,
+                    const uint8_t layer = 0);
+        void submit(const TextureArray* p_texture_array,
+                    const ShaderProgram* p_shader_program,
+                    const SpriteInstance& instance,
+                    const uint8_t layer = 0);
+        void sort();
+        // Sorts if needed, submits everything to the batch and empties the queue;
+        // the stats of that sort stay readable until the next one.
+        void flush(SpriteBatch& batch);
+        // Empties the queue and resets the stats.
+        void clear();
+
+        // Counting switches walks the queue twice per sort, so stats are only
+        // collected when enabled (telemetry, benchmarks).
+        void set_collect_stats(const bool collect) {m_collect_stats = collect;}
+        const Stats& stats() const {return m_stats;}
+        size_t switches_saved() const {return m_stats.switches_unsorted - m_stats.switches_sorted;}
+
+        static uint64_t make_key(const uint8_t layer,
+                                 const bool translucent,
+                                 const uint32_t shader_id,
+                                 const uint32_t texture_id,
+                                 const float depth);
+
+    private:
+        struct Item{
+            GLuint texture_id;
+            const ShaderProgram* p_shader_program;
+            SpriteInstance instance;
+        };
+
+        struct SortEntry{
+            uint64_t key;
+            uint32_t item;
+        };
+
+        void add(const GLuint texture_id, const ShaderProgram* p_shader_program, const SpriteInstance& instance, const uint8_t layer);
+        void clear_items();
+        static size_t count_switches(const std::vector<Item>& items, const std::vector<SortEntry>& order);
+
+        std::vector<Item> m_items;
+        std::vector<SortEntry> m_entries;
+        std::vector<SortEntry> m_scratch;
+        bool m_translucent[256];
+        bool m_is_sorted = true;
+        bool m_collect_stats = false;
+        Stats m_stats;
+    };
+}
@@ -1,11 +1,13 @@
+#include <algorithm>
 #include <iostream>
 
 #include <glm/gtc/type_ptr.hpp>
 
 #include "shader.hpp"
+#include "state_cache.hpp"
 
 namespace Renderer{
-    ShaderProgram::ShaderProgram(const std::string& vertex_shader, const std::string& fragment_shader){
+    ShaderProgram::ShaderProgram(const std::string_view vertex_shader, const std::string_view fragment_shader){
         GLuint vertex_shader_id;
         if (!createShader(vertex_shader, GL_VERTEX_SHADER, vertex_shader_id)){
             std::cerr << "VERTEX SHADER: Compile time error" << std::endl;
@@ -31,6 +33,7 @@ namespace Renderer{
             std::cerr << "SHADER LINK ERROR: Linking time error:\n" << info_log << std::endl;
         }else{
             m_is_compiled = true;
+            reflect_uniforms();
         }
 
         glDeleteShader(vertex_shader_id);
@@ -38,10 +41,12 @@ namespace Renderer{
         
     }
 
-    bool ShaderProgram::createShader(const std::string& source, const GLenum shader_type, GLuint& shader_id){
+    bool ShaderProgram::createShader(const std::string_view source, const GLenum shader_type, GLuint& shader_id){
         shader_id = glCreateShader(shader_type);
-        const char* code = source.c_str();
-        glShaderSource(shader_id, 1, &code, nullptr);
+        // the source is not null terminated when it views a mapped file
+        const char* code = source.data();
+        const GLint length = static_cast<GLint>(source.size());
+        glShaderSource(shader_id, 1, &code, &length);
         glCompileShader(shader_id);
 
         GLint success;
@@ -55,18 +60,63 @@ namespace Renderer{
         return true;
     }
 
+    void ShaderProgram::reflect_uniforms(){
+        GLint uniform_count = 0;
+        glGetProgramInterfaceiv(m_id, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniform_count);
+        GLint max_name_length = 0;
+        glGetProgramInterfaceiv(m_id, GL_UNIFORM, GL_MAX_NAME_LENGTH, &max_name_length);
+
+        m_uniforms.clear();
+        m_uniforms.reserve(uniform_count);
+        std::string name(max_name_length, '\0');
+        const GLenum location_property = GL_LOCATION;
+        for (GLint i = 0; i < uniform_count; ++i){
+            GLint location = -1;
+            glGetProgramResourceiv(m_id, GL_UNIFORM, i, 1, &location_property, 1, nullptr, &location);
+            // members of uniform blocks have no location
+            if (location < 0){
+                continue;
+            }
+            GLsizei name_length = 0;
+            glGetProgramResourceName(m_id, GL_UNIFORM, i, max_name_length, &name_length, name.data());
+            std::string uniform_name(name.data(), name_length);
+            // arrays are reported as "name[0]", look them up by "name"
+            const size_t bracket = uniform_name.find('[');
+            if (bracket != std::string::npos){
+                uniform_name.resize(bracket);
+            }
+            m_uniforms.push_back({std::move(uniform_name), location});
+        }
+        std::sort(m_uniforms.begin(), m_uniforms.end(), [](const Uniform& lhs, const Uniform& rhs){
+            return lhs.name < rhs.name;
+        });
+    }
+
+    UniformId ShaderProgram::uniform_id(const std::string& name) const{
+        auto it = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), name, [](const Uniform& uniform, const std::string& value){
+            return uniform.name < value;
+        });
+        if (it != m_uniforms.end() && it->name == name){
+            return UniformId{it->location};
+        }
+        return UniformId{};
+    }
+
     ShaderProgram::~ShaderProgram(){
+        StateCache::on_program_deleted(m_id);
         glDeleteProgram(m_id);
     }
 
     void ShaderProgram::use() const{
-        glUseProgram(m_id);
+        StateCache::use_program(m_id);
     }
 
     ShaderProgram& ShaderProgram::operator=(ShaderProgram&& shaderProgram) noexcept{
+        StateCache::on_program_deleted(m_id);
         glDeleteProgram(m_id);
         m_id = shaderProgram.m_id;
         m_is_compiled = shaderProgram.m_is_compiled;
+        m_uniforms = std::move(shaderProgram.m_uniforms);
         shaderProgram.m_id = 0;
         shaderProgram.m_is_compiled = false;
         return *this;
@@ -75,15 +125,40 @@ namespace Renderer{
     ShaderProgram::ShaderProgram(ShaderProgram&& shaderProgram) noexcept{
         m_id = shaderProgram.m_id;
         m_is_compiled = shaderProgram.m_is_compiled;
+        m_uniforms = std::move(shaderProgram.m_uniforms);
         shaderProgram.m_id = 0;
         shaderProgram.m_is_compiled = false;
     }
 
+    void ShaderProgram::set_int(const UniformId id, const GLint value){
+        glProgramUniform1i(m_id, id.location, value);
+    }
+
+    void ShaderProgram::set_float(const UniformId id, const GLfloat value){
+        glProgramUniform1f(m_id, id.location, value);
+    }
+
+    void ShaderProgram::set_matrix4(const UniformId id, const glm::mat4& matrix){
+        glProgramUniformMatrix4fv(m_id, id.location, 1, GL_FALSE, glm::value_ptr(matrix));
+    }
+
+    void ShaderProgram::set_vec4(const UniformId id, const glm::vec4& vector){
+        glProgramUniform4fv(m_id, id.location, 1, glm::value_ptr(vector));
+    }
+
     void ShaderProgram::set_int(const std::string& name, const GLint value){
-        glUniform1i(glGetUniformLocation(m_id, name.c_str()), value);
+        set_int(uniform_id(name), value);
+    }
+
+    void ShaderProgram::set_float(const std::string& name, const GLfloat value){
+        set_float(uniform_id(name), value);
     }
 
     void ShaderProgram::set_matrix4(const std::string& name, const glm::mat4& matrix){
-        glUniformMatrix4fv(glGetUniformLocation(m_id, name.c_str()), 1, GL_FALSE, glm::value_ptr(matrix));
+        set_matrix4(uniform_id(name), matrix);
+    }
+
+    void ShaderProgram::set_vec4(const std::string& name, const glm::vec4& vector){
+        set_vec4(uniform_id(name), vector);
     }
 }
\ No newline at end of file
@@ -2,17 +2,34 @@
 
 #include <glad/glad.h>
 #include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace Renderer {
+    // Location of an active uniform, resolved once from the reflection table.
+    struct UniformId{
+        GLint location = -1;
+        bool is_valid() const {return location >= 0;}
+    };
+
     class ShaderProgram{
     public:
-        ShaderProgram(const std::string& vertex_shader, const std::string& fragment_shader);
+        ShaderProgram(const std::string_view vertex_shader, const std::string_view fragment_shader);
         ~ShaderProgram();
         bool isCompiled() const {return m_is_compiled;}
+        GLuint id() const {return m_id;}
         void use() const;
+        UniformId uniform_id(const std::string& name) const;
+        void set_int(const UniformId id, const GLint value);
+        void set_float(const UniformId id, const GLfloat value);
+        void set_matrix4(const UniformId id, const glm::mat4& matrix);
+        void set_vec4(const UniformId id, const glm::vec4& vector);
         void set_int(const std::string& name, const GLint value);
+        void set_float(const std::string& name, const GLfloat value);
         void set_matrix4(const std::string& name, const glm::mat4& matrix);
+        void set_vec4(const std::string& name, const glm::vec4& vector);
 
         ShaderProgram() = delete;
         ShaderProgram(ShaderProgram&) = delete;
@@ -21,7 +38,14 @@ namespace Renderer {
         ShaderProgram(ShaderProgram&& shaderProgram) noexcept;
 
     private:
-        bool createShader(const std::string& source, const GLenum shader_type, GLuint& shader_id);
+        struct Uniform{
+            std::string name;
+            GLint location;
+        };
+
+        bool createShader(const std::string_view source, const GLenum shader_type, GLuint& shader_id);
+        void reflect_uniforms();
+        std::vector<Uniform> m_uniforms; // sorted by name
         bool m_is_compiled = false;
         GLuint m_id = 0;
     };
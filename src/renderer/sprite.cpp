@@ -1,98 +1,93 @@
 #include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "quad_geometry.hpp"
+#include "render_queue.hpp"
 #include "shader.hpp"
 #include "sprite.hpp"
+#include "sprite_batch.hpp"
 #include "texture_2d.hpp"
 
 namespace Renderer{
     Sprite::Sprite(const std::shared_ptr<Texture2D> p_texture,
-                   const std::string initial_tile,
+                   const ResourceName initial_tile,
                    const std::shared_ptr<ShaderProgram> p_shader_program,
+                   const std::shared_ptr<QuadGeometry> p_quad_geometry,
                    const glm::vec2& position,
                    const glm::vec2& size,
                    const float rotation)
                    : m_texture(std::move(p_texture))
                    , m_shader_program(std::move(p_shader_program))
+                   , m_quad_geometry(std::move(p_quad_geometry))
                    , m_position(position)
                    , m_rotation(rotation)
-                   , m_size(size){
-        // 2--3   1
-        // | /  / |
-        // 1   3--2
-        //   x     y     z
-        const GLfloat vertices[] = {
-            0.0f, 0.0f, 0.0f,
-            0.0f, 1.0f, 0.0f,
-            1.0f, 1.0f, 0.0f,
-            1.0f, 1.0f, 0.0f,
-            1.0f, 0.0f, 0.0f,
-            0.0f, 0.0f, 0.0f
-        };
-
-        auto tile = p_texture->get_tile(std::move(initial_tile));
-        //   u     v
-        const GLfloat uv[] = {
-            tile.left_bottom_uv.x, tile.left_bottom_uv.y,
-            tile.left_bottom_uv.x, tile.right_top_uv.y,
-            tile.right_top_uv.x, tile.right_top_uv.y,
-            tile.right_top_uv.x, tile.right_top_uv.y,
-            tile.right_top_uv.x, tile.left_bottom_uv.y,
-            tile.left_bottom_uv.x, tile.left_bottom_uv.y
-        };
-
-        glGenVertexArrays(1, &m_vao);
-        glBindVertexArray(m_vao);
-
-        glGenBuffers(1, &m_vertices_vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, m_vertices_vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-
-        glGenBuffers(1, &m_uv_vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, m_uv_vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(uv), &uv, GL_STATIC_DRAW);
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, 6);
-        glBindVertexArray(0);
-    }
-
-    Sprite::~Sprite(){
-        glDeleteBuffers(1, &m_vertices_vbo);
-        glDeleteBuffers(1, &m_uv_vbo);
-        glDeleteVertexArrays(1, &m_vao);
+                   , m_size(size)
+                   , m_tile(m_texture->get_tile(initial_tile)){
+        if (m_shader_program){
+            m_model_matrix_id = m_shader_program->uniform_id("model_matrix");
+            m_uv_rect_id = m_shader_program->uniform_id("uv_rect");
+        }
     }
 
     void Sprite::render() const{
         m_shader_program->use();
-        glm::mat4 model(1.0f);
-        model = glm::translate(model, glm::vec3(m_position, 0.0f));
-        model = glm::translate(model, glm::vec3(0.5f * m_size.x, -0.5f * m_size.y, 0.0f));
-        model = glm::rotate(model, glm::radians(m_rotation), glm::vec3(0.0f, 0.0f, 1.0f));
-        model = glm::translate(model, glm::vec3(-0.5f * m_size.x, 0.5f * m_size.y, 0.0f));
-        model = glm::scale(model, glm::vec3(m_size, 1.0f));
-
-        glBindVertexArray(m_vao);
-        m_shader_program->set_matrix4("model_matrix", model);
-        glActiveTexture(GL_TEXTURE0);
+        m_quad_geometry->bind();
+        m_shader_program->set_matrix4(m_model_matrix_id, model_matrix());
+        m_shader_program->set_vec4(m_uv_rect_id, glm::vec4(m_tile.left_bottom_uv, m_tile.right_top_uv));
         m_texture->bind();
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        glBindVertexArray(0);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, QuadGeometry::vertex_count);
+    }
+
+    void Sprite::submit(SpriteBatch& batch) const{
+        batch.submit(m_texture.get(), m_shader_program.get(), m_position, m_size, m_rotation, m_tile.left_bottom_uv, m_tile.right_top_uv);
+    }
+
+    void Sprite::submit(RenderQueue& queue, const uint8_t layer) const{
+        queue.submit(m_texture.get(), m_shader_program.get(),
+                     SpriteInstance{m_position, m_size, m_rotation, 0.0f, glm::vec4(m_tile.left_bottom_uv, m_tile.right_top_uv), 0.0f},
+                     layer);
     }
 
     void Sprite::set_position(const glm::vec2& position){
         m_position = position;
+        m_is_model_matrix_dirty = true;
     }
 
     void Sprite::set_rotation(const float rotation){
         m_rotation = rotation;
+        m_is_model_matrix_dirty = true;
+    }
+
+    void Sprite::set_tile(const TileId tile){
+        m_tile = m_texture->get_tile(tile);
     }
 
     void Sprite::set_size(const glm::vec2& size){
         m_size = size;
+        m_is_model_matrix_dirty = true;
+    }
+
+    const glm::mat4& Sprite::model_matrix() const{
+        if (!m_is_model_matrix_dirty){
+            return m_model_matrix;
+        }
+        if (m_rotation == 0.0f){
+            // the rotation pivot translations cancel out, only translate * scale is left
+            m_model_matrix = glm::mat4(1.0f);
+            m_model_matrix[0][0] = m_size.x;
+            m_model_matrix[1][1] = m_size.y;
+            m_model_matrix[3][0] = m_position.x;
+            m_model_matrix[3][1] = m_position.y;
+        }else{
+            m_model_matrix = glm::mat4(1.0f);
+            m_model_matrix = glm::translate(m_model_matrix, glm::vec3(m_position, 0.0f));
+            m_model_matrix = glm::translate(m_model_matrix, glm::vec3(0.5f * m_size.x, -0.5f * m_size.y, 0.0f));
+            m_model_matrix = glm::rotate(m_model_matrix, glm::radians(m_rotation), glm::vec3(0.0f, 0.0f, 1.0f));
+            m_model_matrix = glm::translate(m_model_matrix, glm::vec3(-0.5f * m_size.x, 0.5f * m_size.y, 0.0f));
+            m_model_matrix = glm::scale(m_model_matrix, glm::vec3(m_size, 1.0f));
+        }
+        m_is_model_matrix_dirty = false;
+        return m_model_matrix;
     }
-}
\ No newline at end of file
+}
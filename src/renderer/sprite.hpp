@@ -2,38 +2,56 @@
 
 #include <string>
 #include <memory>
+#include <cstdint>
 
 #include <glad/glad.h>
 #include <glm/vec2.hpp>
+#include <glm/mat4x4.hpp>
+
+#include "shader.hpp"
+#include "texture_2d.hpp"
 
 namespace Renderer{
-    class Texture2D;
-    class ShaderProgram;
+    class SpriteBatch;
+    class RenderQueue;
+    class QuadGeometry;
     class Sprite{
     public:
         Sprite(const std::shared_ptr<Texture2D> p_texture,
-               const std::string initial_tile,
+               const ResourceName initial_tile,
                const std::shared_ptr<ShaderProgram> p_shader_program,
+               const std::shared_ptr<QuadGeometry> p_quad_geometry,
                const glm::vec2& position = glm::vec2(0.0f),
                const glm::vec2& size = glm::vec2(1.0f),
                const float rotation = 0.0f);
-        ~Sprite();
+        virtual ~Sprite() = default;
         Sprite(const Sprite&) = delete;
         Sprite& operator=(const Sprite&) = delete;
 
         virtual void render() const;
+        void submit(SpriteBatch& batch) const;
+        void submit(RenderQueue& queue, const uint8_t layer = 0) const;
         void set_position(const glm::vec2& position);
         void set_rotation(const float rotation);
         void set_size(const glm::vec2& size);
+        // Shows another tile of the texture; only the UV rect the sprite passes
+        // to the shader (uv_rect uniform or instance data) changes.
+        void set_tile(const TileId tile);
+        void set_tile(const ResourceName tile) {set_tile(m_texture->find_tile(tile));}
+        const glm::mat4& model_matrix() const;
 
     protected:
         std::shared_ptr<Texture2D> m_texture;
         std::shared_ptr<ShaderProgram> m_shader_program;
+        std::shared_ptr<QuadGeometry> m_quad_geometry;
         glm::vec2 m_position;
         glm::vec2 m_size;
         float m_rotation;
-        GLuint m_vao;
-        GLuint m_vertices_vbo;
-        GLuint m_uv_vbo;
+        Texture2D::Tile m_tile;
+        UniformId m_model_matrix_id;
+        UniformId m_uv_rect_id;
+        // recomputed lazily after set_position, set_rotation or set_size
+        mutable glm::mat4 m_model_matrix;
+        mutable bool m_is_model_matrix_dirty = true;
     };
 }
@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <glm/trigonometric.hpp>
+
+#include "quad_geometry.hpp"
+#include "shader.hpp"
+#include "sprite_batch.hpp"
+#include "state_cache.hpp"
+#include "texture_2d.hpp"
+#include "texture_array.hpp"
+#include "transform_store.hpp"
+
+namespace Renderer{
+    // room for a few full batches per frame before the stream buffer has to move on
+    static const size_t stream_batches_per_region = 4;
+
+    SpriteBatch::SpriteBatch(const std::shared_ptr<QuadGeometry> p_quad_geometry,
+                             const Mode mode,
+                             const size_t max_sprites)
+                             : m_quad_geometry(std::move(p_quad_geometry))
+                             , m_mode(mode)
+                             , m_max_sprites(max_sprites)
+                             , m_stream_buffer(static_cast<GLsizeiptr>(max_sprites * 4 * sizeof(Vertex) * stream_batches_per_region)){
+        // 1--2
+        // | /|
+        // 0--3
+        std::vector<GLuint> indices(m_max_sprites * 6);
+        for (size_t i = 0; i < m_max_sprites; ++i){
+            const GLuint first = static_cast<GLuint>(i * 4);
+            indices[i * 6 + 0] = first + 0;
+            indices[i * 6 + 1] = first + 1;
+            indices[i * 6 + 2] = first + 2;
+            indices[i * 6 + 3] = first + 2;
+            indices[i * 6 + 4] = first + 3;
+            indices[i * 6 + 5] = first + 0;
+        }
+
+        glCreateBuffers(1, &m_ebo);
+        glNamedBufferStorage(m_ebo, indices.size() * sizeof(GLuint), indices.data(), 0);
+
+        glCreateVertexArrays(1, &m_vertices_vao);
+        glVertexArrayVertexBuffer(m_vertices_vao, 0, m_stream_buffer.id(), 0, sizeof(Vertex));
+        glVertexArrayElementBuffer(m_vertices_vao, m_ebo);
+        set_attribute(m_vertices_vao, 0, 0, 3, offsetof(Vertex, position));
+        set_attribute(m_vertices_vao, 1, 0, 2, offsetof(Vertex, uv));
+        set_attribute(m_vertices_vao, 2, 0, 1, offsetof(Vertex, texture_layer));
+
+        // binding 0: the shared unit quad, binding 1: one SpriteInstance per instance
+        glCreateVertexArrays(1, &m_instances_vao);
+        glVertexArrayVertexBuffer(m_instances_vao, 0, m_quad_geometry->vertices_vbo(), 0, 2 * sizeof(GLfloat));
+        glVertexArrayVertexBuffer(m_instances_vao, 1, m_stream_buffer.id(), 0, sizeof(SpriteInstance));
+        glVertexArrayBindingDivisor(m_instances_vao, 1, 1);
+        set_attribute(m_instances_vao, 0, 0, 2, 0);
+        set_attribute(m_instances_vao, 1, 1, 2, offsetof(SpriteInstance, position));
+        set_attribute(m_instances_vao, 2, 1, 2, offsetof(SpriteInstance, size));
+        set_attribute(m_instances_vao, 3, 1, 1, offsetof(SpriteInstance, rotation));
+        set_attribute(m_instances_vao, 4, 1, 1, offsetof(SpriteInstance, layer));
+        set_attribute(m_instances_vao, 5, 1, 4, offsetof(SpriteInstance, uv_rect));
+        set_attribute(m_instances_vao, 6, 1, 1, offsetof(SpriteInstance, texture_layer));
+    }
+
+    void SpriteBatch::set_attribute(const GLuint vao, const GLuint attribute, const GLuint binding, const GLint size, const size_t offset){
+        glEnableVertexArrayAttrib(vao, attribute);
+        glVertexArrayAttribFormat(vao, attribute, size, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offset));
+        glVertexArrayAttribBinding(vao, attribute, binding);
+    }
+
+    SpriteBatch::~SpriteBatch(){
+        glDeleteBuffers(1, &m_ebo);
+        StateCache::on_vertex_array_deleted(m_vertices_vao);
+        glDeleteVertexArrays(1, &m_vertices_vao);
+        StateCache::on_vertex_array_deleted(m_instances_vao);
+        glDeleteVertexArrays(1, &m_instances_vao);
+    }
+
+    void SpriteBatch::begin(){
+        m_queued_sprites = 0;
+        m_capacity = 0;
+        m_texture_id = 0;
+        m_shader_program = nullptr;
+        m_draw_calls = 0;
+        m_sprite_count = 0;
+    }
+
+    void SpriteBatch::submit(const Texture2D* p_texture,
+                             const ShaderProgram* p_shader_program,
+                             const glm::vec2& position,
+                             const glm::vec2& size,
+                             const float rotation,
+                             const glm::vec2& left_bottom_uv,
+                             const glm::vec2& right_top_uv,
+                             const float layer){
+        submit(p_texture, p_shader_program, SpriteInstance{position, size, rotation, layer, glm::vec4(left_bottom_uv, right_top_uv), 0.0f});
+    }
+
+    void SpriteBatch::submit(const Texture2D* p_texture,
+                             const ShaderProgram* p_shader_program,
+                             const SpriteInstance& instance){
+        submit_texture_id(p_texture->id(), p_shader_program, instance);
+    }
+
+    void SpriteBatch::submit(const TextureArray* p_texture_array,
+                             const ShaderProgram* p_shader_program,
+                             const SpriteInstance& instance){
+        submit_texture_id(p_texture_array->id(), p_shader_program, instance);
+    }
+
+    void SpriteBatch::submit_texture_id(const GLuint texture_id,
+                                        const ShaderProgram* p_shader_program,
+                                        const SpriteInstance& instance){
+        if (!prepare(texture_id, p_shader_program)){
+            return;
+        }
+        if (m_mode == Mode::Instanced){
+            instances()[m_queued_sprites] = instance;
+        }else{
+            write_quad(&vertices()[m_queued_sprites * 4], instance);
+        }
+        ++m_queued_sprites;
+        ++m_sprite_count;
+    }
+
+    void SpriteBatch::submit(const Texture2D* p_texture,
+                             const ShaderProgram* p_shader_program,
+                             const TransformStore& transforms){
+        submit_transforms(p_texture->id(), p_shader_program, transforms);
+    }
+
+    void SpriteBatch::submit(const TextureArray* p_texture_array,
+                             const ShaderProgram* p_shader_program,
+                             const TransformStore& transforms){
+        submit_transforms(p_texture_array->id(), p_shader_program, transforms);
+    }
+
+    void SpriteBatch::submit_transforms(const GLuint texture_id,
+                                        const ShaderProgram* p_shader_program,
+                                        const TransformStore& transforms){
+        size_t first = 0;
+        while (first < transforms.size()){
+            if (!prepare(texture_id, p_shader_program)){
+                return;
+            }
+            const size_t count = std::min(transforms.size() - first, m_capacity - m_queued_sprites);
+            if (m_mode == Mode::Instanced){
+                transforms.write_instances(&instances()[m_queued_sprites], first, count);
+            }else{
+                transforms.write_quads(&vertices()[m_queued_sprites * 4], first, count);
+            }
+            m_queued_sprites += count;
+            m_sprite_count += count;
+            first += count;
+        }
+    }
+
+    bool SpriteBatch::prepare(const GLuint texture_id, const ShaderProgram* p_shader_program){
+        if (texture_id != m_texture_id || p_shader_program != m_shader_program || m_queued_sprites == m_capacity){
+            flush();
+            m_texture_id = texture_id;
+            m_shader_program = p_shader_program;
+        }
+        if (m_queued_sprites == 0){
+            const GLsizeiptr stride = sprite_stride();
+            m_allocation = m_stream_buffer.reserve(stride);
+            if (m_allocation.size < stride){
+                m_stream_buffer.next_region();
+                m_allocation = m_stream_buffer.reserve(stride);
+            }
+            m_capacity = std::min(m_max_sprites, static_cast<size_t>(m_allocation.size / stride));
+        }
+        return m_capacity > m_queued_sprites;
+    }
+
+    void SpriteBatch::end(){
+        flush();
+        m_stream_buffer.next_region();
+        m_capacity = 0;
+    }
+
+    void SpriteBatch::set_mode(const Mode mode){
+        flush();
+        m_capacity = 0;
+        m_mode = mode;
+    }
+
+    GLsizeiptr SpriteBatch::sprite_stride() const{
+        return m_mode == Mode::Instanced ? sizeof(SpriteInstance) : 4 * sizeof(Vertex);
+    }
+
+    void SpriteBatch::flush(){
+        if (m_queued_sprites == 0){
+            return;
+        }
+
+        m_shader_program->use();
+        StateCache::bind_texture(0, m_texture_id);
+        const GLsizei count = static_cast<GLsizei>(m_queued_sprites);
+        if (m_mode == Mode::Instanced){
+            StateCache::bind_vertex_array(m_instances_vao);
+            const GLuint base_instance = static_cast<GLuint>(m_allocation.offset / sizeof(SpriteInstance));
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, QuadGeometry::vertex_count, count, base_instance);
+        }else{
+            StateCache::bind_vertex_array(m_vertices_vao);
+            const GLint base_vertex = static_cast<GLint>(m_allocation.offset / sizeof(Vertex));
+            glDrawElementsBaseVertex(GL_TRIANGLES, count * 6, GL_UNSIGNED_INT, nullptr, base_vertex);
+        }
+        m_stream_buffer.commit(m_queued_sprites * sprite_stride());
+
+        ++m_draw_calls;
+        m_queued_sprites = 0;
+        m_capacity = 0;
+    }
+
+    void SpriteBatch::write_quad(Vertex* p_out, const SpriteInstance& instance){
+        const glm::vec2& position = instance.position;
+        const glm::vec2& size = instance.size;
+        // Sprite::render rotates around position + (0.5 * w, -0.5 * h)
+        const glm::vec2 pivot(position.x + 0.5f * size.x, position.y - 0.5f * size.y);
+        const float x0 = -0.5f * size.x;
+        const float x1 = 0.5f * size.x;
+        const float y0 = 0.5f * size.y;
+        const float y1 = 1.5f * size.y;
+        const float z = instance.layer;
+
+        if (instance.rotation == 0.0f){
+            p_out[0].position = glm::vec3(pivot.x + x0, pivot.y + y0, z);
+            p_out[1].position = glm::vec3(pivot.x + x0, pivot.y + y1, z);
+            p_out[2].position = glm::vec3(pivot.x + x1, pivot.y + y1, z);
+            p_out[3].position = glm::vec3(pivot.x + x1, pivot.y + y0, z);
+        }else{
+            const float c = std::cos(glm::radians(instance.rotation));
+            const float s = std::sin(glm::radians(instance.rotation));
+            p_out[0].position = glm::vec3(pivot.x + c * x0 - s * y0, pivot.y + s * x0 + c * y0, z);
+            p_out[1].position = glm::vec3(pivot.x + c * x0 - s * y1, pivot.y + s * x0 + c * y1, z);
+            p_out[2].position = glm::vec3(pivot.x + c * x1 - s * y1, pivot.y + s * x1 + c * y1, z);
+            p_out[3].position = glm::vec3(pivot.x + c * x1 - s * y0, pivot.y + s * x1 + c * y0, z);
+        }
+
+        const glm::vec4& uv = instance.uv_rect;
+        p_out[0].uv = glm::vec2(uv.x, uv.y);
+        p_out[1].uv = glm::vec2(uv.x, uv.w);
+        p_out[2].uv = glm::vec2(uv.z, uv.w);
+        p_out[3].uv = glm::vec2(uv.z, uv.y);
+        for (size_t i = 0; i < 4; ++i){
+            p_out[i].texture_layer = instance.texture_layer;
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "stream_buffer.hpp"
+
+namespace Renderer{
+    class Texture2D;
+    class TextureArray;
+    class ShaderProgram;
+    class QuadGeometry;
+    class TransformStore;
+
+    // Per-sprite data as it is laid out in the instance buffer (see sprite_instanced.vert).
+    struct SpriteInstance{
+        glm::vec2 position;
+        glm::vec2 size;
+        float rotation;
+        float layer;
+        glm::vec4 uv_rect; // left_bottom_uv, right_top_uv
+        float texture_layer; // layer of a TextureArray, 0 for a Texture2D
+    };
+
+    // Collects sprites submitted during a frame and issues a single draw per run
+    // of sprites sharing a texture and shader; with a TextureArray that run
+    // spans every sheet in the array. Sprites are written straight into
+    // a persistently mapped StreamBuffer as they are submitted: in Mode::Vertices
+    // as four expanded vertices, in Mode::Instanced as one SpriteInstance drawn
+    // over the shared unit quad with the transform built in the shader.
+    class SpriteBatch{
+    public:
+        enum class Mode{
+            Vertices,
+            Instanced
+        };
+
+        struct Vertex{
+            glm::vec3 position;
+            glm::vec2 uv;
+            float texture_layer;
+        };
+
+        SpriteBatch(const std::shared_ptr<QuadGeometry> p_quad_geometry,
+                    const Mode mode = Mode::Vertices,
+                    const size_t max_sprites = 16384);
+        ~SpriteBatch();
+        SpriteBatch(const SpriteBatch&) = delete;
+        SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+        void begin();
+        void submit(const Texture2D* p_texture,
+                    const ShaderProgram* p_shader_program,
+                    const glm::vec2& position,
+                    const glm::vec2& size,
+                    const float rotation,
+                    const glm::vec2& left_bottom_uv,
+                    const glm::vec2& right_top_uv,
+                    const float layer = 0.0f);
+        void submit(const Texture2D* p_texture,
+                    const ShaderProgram* p_shader_program,
+                    const SpriteInstance& instance);
+        void submit(const TextureArray* p_texture_array,
+                    const ShaderProgram* p_shader_program,
+                    const SpriteInstance& instance);
+        // Submits every sprite of the store, expanded by its SIMD kernel.
+        void submit(const Texture2D* p_texture,
+                    const ShaderProgram* p_shader_program,
+                    const TransformStore& transforms);
+        void submit(const TextureArray* p_texture_array,
+                    const ShaderProgram* p_shader_program,
+                    const TransformStore& transforms);
+        // Same as submit, for callers that only keep the GL name of a Texture2D or TextureArray.
+        void submit_texture_id(const GLuint texture_id,
+                               const ShaderProgram* p_shader_program,
+                               const SpriteInstance& instance);
+        void end();
+
+        void set_mode(const Mode mode);
+        Mode mode() const {return m_mode;}
+        size_t draw_calls() const {return m_draw_calls;}
+        size_t sprite_count() const {return m_sprite_count;}
+        size_t stream_stalls() const {return m_stream_buffer.stall_count();}
+
+        // Writes the four corners of a sprite quad, using the same transform as Sprite::render.
+        static void write_quad(Vertex* p_out, const SpriteInstance& instance);
+
+    private:
+        static void set_attribute(const GLuint vao, const GLuint attribute, const GLuint binding, const GLint size, const size_t offset);
+        // Flushes if needed and makes room for at least one sprite; false when the
+        // stream buffer has no memory to write to.
+        bool prepare(const GLuint texture_id, const ShaderProgram* p_shader_program);
+        void submit_transforms(const GLuint texture_id, const ShaderProgram* p_shader_program, const TransformStore& transforms);
+        void flush();
+        GLsizeiptr sprite_stride() const;
+        Vertex* vertices() const {return static_cast<Vertex*>(m_allocation.p_data);}
+        SpriteInstance* instances() const {return static_cast<SpriteInstance*>(m_allocation.p_data);}
+
+        std::shared_ptr<QuadGeometry> m_quad_geometry;
+        Mode m_mode;
+        size_t m_max_sprites;
+        StreamBuffer m_stream_buffer;
+        StreamBuffer::Allocation m_allocation{nullptr, 0, 0};
+        size_t m_capacity = 0;  // sprites that fit into m_allocation
+        size_t m_queued_sprites = 0;
+        GLuint m_texture_id = 0;
+        const ShaderProgram* m_shader_program = nullptr;
+        size_t m_draw_calls = 0;
+        size_t m_sprite_count = 0;
+
+        GLuint m_vertices_vao = 0;
+        GLuint m_ebo = 0;
+        GLuint m_instances_vao = 0;
+    };
+}
@@ -0,0 +1,71 @@
+#include "state_cache.hpp"
+
+namespace Renderer{
+    GLuint StateCache::s_program = 0;
+    GLuint StateCache::s_vertex_array = 0;
+    GLuint StateCache::s_textures[StateCache::max_texture_units] = {};
+    StateCache::Counters StateCache::s_counters;
+
+    void StateCache::use_program(const GLuint id){
+        if (s_program == id){
+            ++s_counters.skipped_binds;
+            return;
+        }
+        glUseProgram(id);
+        s_program = id;
+        ++s_counters.program_binds;
+    }
+
+    void StateCache::bind_texture(const GLuint unit, const GLuint id){
+        if (s_textures[unit] == id){
+            ++s_counters.skipped_binds;
+            return;
+        }
+        glBindTextureUnit(unit, id);
+        s_textures[unit] = id;
+        ++s_counters.texture_binds;
+    }
+
+    void StateCache::bind_vertex_array(const GLuint id){
+        if (s_vertex_array == id){
+            ++s_counters.skipped_binds;
+            return;
+        }
+        glBindVertexArray(id);
+        s_vertex_array = id;
+        ++s_counters.vertex_array_binds;
+    }
+
+    void StateCache::on_program_deleted(const GLuint id){
+        // a deleted program stays in use until another one is installed
+        if (s_program == id){
+            s_program = unknown;
+        }
+    }
+
+    void StateCache::on_texture_deleted(const GLuint id){
+        for (GLuint& texture : s_textures){
+            if (texture == id){
+                texture = 0;
+            }
+        }
+    }
+
+    void StateCache::on_vertex_array_deleted(const GLuint id){
+        if (s_vertex_array == id){
+            s_vertex_array = 0;
+        }
+    }
+
+    void StateCache::invalidate(){
+        s_program = unknown;
+        s_vertex_array = unknown;
+        for (GLuint& texture : s_textures){
+            texture = unknown;
+        }
+    }
+
+    void StateCache::reset_counters(){
+        s_counters = Counters();
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+namespace Renderer{
+    // Shadow copy of the GL binding state the renderer touches. Every program,
+    // texture and vertex array bind goes through here so binds that would not
+    // change anything are skipped; the counters report what was actually issued.
+    class StateCache{
+    public:
+        struct Counters{
+            size_t program_binds = 0;
+            size_t texture_binds = 0;
+            size_t vertex_array_binds = 0;
+            size_t skipped_binds = 0;
+        };
+
+        static constexpr GLuint max_texture_units = 32;
+
+        static void use_program(const GLuint id);
+        // binds to the unit directly (glBindTextureUnit), whatever the texture's target
+        static void bind_texture(const GLuint unit, const GLuint id);
+        static void bind_vertex_array(const GLuint id);
+
+        // GL unbinds deleted objects itself, the cache has to forget them too
+        static void on_program_deleted(const GLuint id);
+        static void on_texture_deleted(const GLuint id);
+        static void on_vertex_array_deleted(const GLuint id);
+        static void invalidate();
+
+        static const Counters& counters() {return s_counters;}
+        static void reset_counters();
+
+        StateCache() = delete;
+
+    private:
+        // forces the next bind to be issued
+        static constexpr GLuint unknown = ~0u;
+
+        static GLuint s_program;
+        static GLuint s_vertex_array;
+        static GLuint s_textures[max_texture_units];
+        static Counters s_counters;
+    };
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+
+#include "stream_buffer.hpp"
+
+namespace Renderer{
+    StreamBuffer::StreamBuffer(const GLsizeiptr region_size, const GLuint region_count)
+                               : m_region_size(region_size)
+                               , m_region_count(region_count)
+                               , m_fences(region_count, nullptr){
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const GLsizeiptr total_size = m_region_size * m_region_count;
+
+        glCreateBuffers(1, &m_id);
+        glNamedBufferStorage(m_id, total_size, nullptr, flags);
+        m_p_data = static_cast<unsigned char*>(glMapNamedBufferRange(m_id, 0, total_size, flags));
+        if (!m_p_data){
+            std::cerr << "STREAM BUFFER: Can't map " << total_size << " bytes" << std::endl;
+        }
+    }
+
+    StreamBuffer::~StreamBuffer(){
+        for (GLsync fence : m_fences){
+            if (fence){
+                glDeleteSync(fence);
+            }
+        }
+        if (m_p_data){
+            glUnmapNamedBuffer(m_id);
+        }
+        glDeleteBuffers(1, &m_id);
+    }
+
+    StreamBuffer::Allocation StreamBuffer::reserve(const GLsizeiptr alignment){
+        if (!m_p_data){
+            return Allocation{nullptr, 0, 0};
+        }
+        const GLintptr region_start = static_cast<GLintptr>(m_region) * m_region_size;
+        // align the absolute offset so it can be used as a base vertex / base instance
+        GLintptr offset = region_start + m_offset;
+        offset = (offset + alignment - 1) / alignment * alignment;
+        m_reserved = offset - region_start;
+        if (m_reserved >= m_region_size){
+            m_reserved = m_region_size;
+            return Allocation{nullptr, offset, 0};
+        }
+        return Allocation{m_p_data + offset, offset, m_region_size - m_reserved};
+    }
+
+    void StreamBuffer::commit(const GLsizeiptr size){
+        m_offset = m_reserved + size;
+    }
+
+    void StreamBuffer::next_region(){
+        if (m_fences[m_region]){
+            glDeleteSync(m_fences[m_region]);
+        }
+        m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_region = (m_region + 1) % m_region_count;
+        m_offset = 0;
+        m_reserved = 0;
+        wait(m_region);
+    }
+
+    void StreamBuffer::wait(const GLuint region){
+        GLsync fence = m_fences[region];
+        if (!fence){
+            return;
+        }
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED){
+            ++m_stall_count;
+            do{
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            }while (result == GL_TIMEOUT_EXPIRED);
+        }
+        if (result == GL_WAIT_FAILED){
+            std::cerr << "STREAM BUFFER: Waiting for the GPU failed" << std::endl;
+        }
+        glDeleteSync(fence);
+        m_fences[region] = nullptr;
+    }
+}
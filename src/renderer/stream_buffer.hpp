@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace Renderer{
+    // Persistently mapped, coherent buffer split into region_count regions that
+    // are written round-robin, one per frame. A fence is placed when a region is
+    // retired and waited on only when the CPU comes back around to it, so
+    // writes go straight into GPU-visible memory without re-specifying storage.
+    class StreamBuffer{
+    public:
+        struct Allocation{
+            void* p_data;
+            GLintptr offset;  // from the start of the buffer
+            GLsizeiptr size;  // bytes left in the current region
+        };
+
+        StreamBuffer(const GLsizeiptr region_size, const GLuint region_count = 3);
+        ~StreamBuffer();
+        StreamBuffer(const StreamBuffer&) = delete;
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+        // Returns the rest of the current region, starting at a multiple of alignment;
+        // the allocation is empty when the buffer couldn't be mapped.
+        Allocation reserve(const GLsizeiptr alignment);
+        // Marks size bytes from the last reserve as used.
+        void commit(const GLsizeiptr size);
+        // Fences the current region and moves on to the next one, waiting if the GPU still reads it.
+        void next_region();
+
+        bool is_mapped() const {return m_p_data != nullptr;}
+        GLuint id() const {return m_id;}
+        GLsizeiptr region_size() const {return m_region_size;}
+        size_t stall_count() const {return m_stall_count;}
+
+    private:
+        void wait(const GLuint region);
+
+        GLuint m_id = 0;
+        unsigned char* m_p_data = nullptr;
+        GLsizeiptr m_region_size;
+        GLuint m_region_count;
+        GLuint m_region = 0;
+        GLintptr m_offset = 0;     // inside the current region
+        GLintptr m_reserved = 0;   // start of the last reservation inside the region
+        std::vector<GLsync> m_fences;
+        size_t m_stall_count = 0;
+    };
+}
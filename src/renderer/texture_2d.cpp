@@ -1,42 +1,71 @@
+#include <algorithm>
+
+#include "state_cache.hpp"
 #include "texture_2d.hpp"
 
 namespace Renderer{
+    static bool is_mipmap_filter(const GLenum filter){
+        return filter == GL_NEAREST_MIPMAP_NEAREST || filter == GL_NEAREST_MIPMAP_LINEAR ||
+               filter == GL_LINEAR_MIPMAP_NEAREST || filter == GL_LINEAR_MIPMAP_LINEAR;
+    }
+
+    static bool is_nearest_filter(const GLenum filter){
+        return filter == GL_NEAREST || filter == GL_NEAREST_MIPMAP_NEAREST || filter == GL_NEAREST_MIPMAP_LINEAR;
+    }
+
     Texture2D::Texture2D(const GLuint width, GLuint height,
                          const unsigned char* data,
                          const unsigned int channels,
                          const GLenum filter,
-                         const GLenum wrap_mode)
+                         const GLenum wrap_mode,
+                         const bool skip_mipmaps)
                          : m_width(width), m_height(height){
+        GLenum internal_format;
         switch (channels){
             case 4:
                 m_mode = GL_RGBA;
+                internal_format = GL_RGBA8;
                 break;
             case 3:
                 m_mode = GL_RGB;
+                internal_format = GL_RGB8;
                 break;
             default:
                 m_mode = GL_RGBA;
+                internal_format = GL_RGBA8;
                 break;
         }
-        glGenTextures(1, &m_id);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_id);
-        //second - mipmap
-        glTexImage2D(GL_TEXTURE_2D, 0, m_mode, m_width, m_height, 0, m_mode, GL_UNSIGNED_BYTE, data);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_mode);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_mode);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, 0);
+
+        m_mip_levels = 1;
+        if (is_mipmap_filter(filter) && !skip_mipmaps){
+            for (GLuint size = std::max(m_width, m_height); size > 1; size /= 2){
+                ++m_mip_levels;
+            }
+        }
+        // only the minification filter may use mipmaps
+        const GLenum single_level_filter = is_nearest_filter(filter) ? GL_NEAREST : GL_LINEAR;
+        const GLenum min_filter = m_mip_levels > 1 ? filter : single_level_filter;
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
+        glTextureStorage2D(m_id, m_mip_levels, internal_format, m_width, m_height);
+        glTextureParameteri(m_id, GL_TEXTURE_MAX_LEVEL, m_mip_levels - 1);
+
+        glTextureParameteri(m_id, GL_TEXTURE_WRAP_S, wrap_mode);
+        glTextureParameteri(m_id, GL_TEXTURE_WRAP_T, wrap_mode);
+        glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, min_filter);
+        glTextureParameteri(m_id, GL_TEXTURE_MAG_FILTER, single_level_filter);
+        if (data){
+            set_pixels(data);
+        }
     }
 
     Texture2D& Texture2D::operator=(Texture2D&& texture_2d){
+        StateCache::on_texture_deleted(m_id);
         glDeleteTextures(1, &m_id);
         m_id = texture_2d.m_id;
         texture_2d.m_id = 0;
         m_mode = texture_2d.m_mode;
+        m_mip_levels = texture_2d.m_mip_levels;
         m_width = texture_2d.m_width;
         m_height = texture_2d.m_height;
         return *this;
@@ -46,28 +75,56 @@ namespace Renderer{
         m_id = texture_2d.m_id;
         texture_2d.m_id = 0;
         m_mode = texture_2d.m_mode;
+        m_mip_levels = texture_2d.m_mip_levels;
         m_width = texture_2d.m_width;
         m_height = texture_2d.m_height;
     }
 
     Texture2D::~Texture2D(){
+        StateCache::on_texture_deleted(m_id);
         glDeleteTextures(1, &m_id);
     }
 
-    void Texture2D::bind() const{
-        glBindTexture(GL_TEXTURE_2D, m_id);
+    void Texture2D::bind(const GLuint unit) const{
+        StateCache::bind_texture(unit, m_id);
     }
 
-    void Texture2D::add_tile(std::string name, const glm::vec2& left_bottom_uv, const glm::vec2& right_top_uv){
-        m_tile.emplace(std::move(name), Tile(left_bottom_uv, right_top_uv));
+    void Texture2D::set_pixels(const void* pixels){
+        set_pixels(0, 0, m_width, m_height, pixels, m_mode == GL_RGB ? 3 : 4);
+        if (m_mip_levels > 1){
+            glGenerateTextureMipmap(m_id);
+        }
+    }
+
+    void Texture2D::set_pixels(const GLint x, const GLint y, const GLsizei width, const GLsizei height,
+                               const void* pixels, const unsigned int channels){
+        const GLenum format = channels == 3 ? GL_RGB : GL_RGBA;
+        // tightly packed RGB rows aren't 4-byte aligned for most widths
+        const bool unaligned_rows = (width * channels) % 4 != 0;
+        if (unaligned_rows){
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        }
+        glTextureSubImage2D(m_id, 0, x, y, width, height, format, GL_UNSIGNED_BYTE, pixels);
+        if (unaligned_rows){
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
     }
 
-    const Texture2D::Tile& Texture2D::get_tile(const std::string& name) const{
-        auto it = m_tile.find(name);
-        if (it != m_tile.end()){
-            return it->second;
+    TileId Texture2D::add_tile(const std::string_view name, const glm::vec2& left_bottom_uv, const glm::vec2& right_top_uv){
+        auto result = m_tile_ids.emplace(ResourceName::registered(name).value(), static_cast<TileId>(m_tiles.size()));
+        if (result.second){
+            m_tiles.emplace_back(left_bottom_uv, right_top_uv);
         }
-        const static Tile default_tile;
-        return default_tile;
+        return result.first->second;
+    }
+
+    TileId Texture2D::find_tile(const ResourceName name) const{
+        auto it = m_tile_ids.find(name.value());
+        return it != m_tile_ids.end() ? it->second : invalid_tile_id;
+    }
+
+    const Texture2D::Tile& Texture2D::default_tile(){
+        const static Tile tile;
+        return tile;
     }
 }
\ No newline at end of file
@@ -3,7 +3,12 @@
 #include <glad/glad.h>
 #include <glm/vec2.hpp>
 #include <string>
-#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "tile_id.hpp"
+#include "../resources/resource_name.hpp"
 
 namespace Renderer{
     class Texture2D{
@@ -22,27 +27,51 @@ namespace Renderer{
                 , right_top_uv(1.0f){}
         };
 
+        // Storage is immutable. A mipmapped filter allocates the full mip chain,
+        // GL_NEAREST / GL_LINEAR a single level; skip_mipmaps forces a single level
+        // (the filter drops its mipmap part). data may be null to allocate the
+        // storage only and fill it with set_pixels.
         Texture2D(const GLuint width, GLuint height,
                   const unsigned char* data, const unsigned int channels = 4,
-                  const GLenum filter = GL_LINEAR, const GLenum wrap_mode = GL_CLAMP_TO_EDGE);
+                  const GLenum filter = GL_LINEAR, const GLenum wrap_mode = GL_CLAMP_TO_EDGE,
+                  const bool skip_mipmaps = false);
         Texture2D() = delete;
         Texture2D(const Texture2D&) = delete;
         Texture2D& operator=(const Texture2D&) = delete;
+        // Takes over the GL texture and size but keeps this texture's tiles, so a
+        // placeholder can be replaced in place by the loaded texture.
         Texture2D& operator=(Texture2D&& texture_2d);
         Texture2D(Texture2D&& texture_2d);
         ~Texture2D();
 
-        void add_tile(std::string name, const glm::vec2& left_bottom_uv, const glm::vec2& right_top_uv);
-        const Tile& get_tile(const std::string& name) const;
+        // Ids are assigned in insertion order; adding a name twice keeps the first tile.
+        TileId add_tile(const std::string_view name, const glm::vec2& left_bottom_uv, const glm::vec2& right_top_uv);
+        TileId find_tile(const ResourceName name) const;
+        const Tile& get_tile(const TileId id) const {return id < m_tiles.size() ? m_tiles[id] : default_tile();}
+        const Tile& get_tile(const ResourceName name) const {return get_tile(find_tile(name));}
+        size_t tile_count() const {return m_tiles.size();}
         unsigned int width() const {return m_width;}
         unsigned int height() const {return m_height;}
-        void bind() const;
+        GLsizei mip_levels() const {return m_mip_levels;}
+        GLuint id() const {return m_id;}
+        void bind(const GLuint unit = 0) const;
+        // Replaces the whole image (tightly packed rows) and rebuilds the mipmaps, if
+        // any; pixels is an offset when a GL_PIXEL_UNPACK_BUFFER is bound.
+        void set_pixels(const void* pixels);
+        // Replaces the rectangle at (x, y) with pixels of the given channel count;
+        // the mipmaps are left untouched.
+        void set_pixels(const GLint x, const GLint y, const GLsizei width, const GLsizei height,
+                        const void* pixels, const unsigned int channels = 4);
 
     private:
+        static const Tile& default_tile();
+
         GLuint m_id;
         GLenum m_mode;
+        GLsizei m_mip_levels;
         unsigned int m_width;
         unsigned int m_height;
-        std::map<std::string, Tile> m_tile;
+        std::vector<Tile> m_tiles;
+        std::unordered_map<uint64_t, TileId> m_tile_ids;  // by ResourceName
     };
 }
\ No newline at end of file
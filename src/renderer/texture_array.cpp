@@ -0,0 +1,75 @@
+#include <iostream>
+
+#include "state_cache.hpp"
+#include "texture_array.hpp"
+
+namespace Renderer{
+    TextureArray::TextureArray(const GLuint width, const GLuint height, const GLuint layer_count,
+                               const GLenum filter, const GLenum wrap_mode)
+                               : m_width(width), m_height(height), m_layer_count(layer_count)
+                               , m_layer_uv_scale(layer_count, glm::vec2(1.0f)){
+        // sheets are packed tightly into layers, so no mipmaps: they would bleed across sheets and tiles
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_id);
+        glTextureStorage3D(m_id, 1, GL_RGBA8, m_width, m_height, m_layer_count);
+        glTextureParameteri(m_id, GL_TEXTURE_MAX_LEVEL, 0);
+        glTextureParameteri(m_id, GL_TEXTURE_WRAP_S, wrap_mode);
+        glTextureParameteri(m_id, GL_TEXTURE_WRAP_T, wrap_mode);
+        glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, filter);
+        glTextureParameteri(m_id, GL_TEXTURE_MAG_FILTER, filter);
+    }
+
+    TextureArray::~TextureArray(){
+        StateCache::on_texture_deleted(m_id);
+        glDeleteTextures(1, &m_id);
+    }
+
+    void TextureArray::set_layer(const GLuint layer, const GLuint width, const GLuint height,
+                                 const unsigned char* data, const unsigned int channels){
+        if (layer >= m_layer_count || width > m_width || height > m_height){
+            std::cerr << "TEXTURE ARRAY: " << width << "x" << height << " sheet doesn't fit layer " << layer
+                      << " of a " << m_width << "x" << m_height << "x" << m_layer_count << " array" << std::endl;
+            return;
+        }
+        const GLenum mode = channels == 3 ? GL_RGB : GL_RGBA;
+        // tightly packed RGB rows aren't 4-byte aligned for most widths
+        const bool unaligned_rows = (width * channels) % 4 != 0;
+        if (unaligned_rows){
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        }
+        glTextureSubImage3D(m_id, 0, 0, 0, layer, width, height, 1, mode, GL_UNSIGNED_BYTE, data);
+        if (unaligned_rows){
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
+        m_layer_uv_scale[layer] = glm::vec2(width, height) / glm::vec2(m_width, m_height);
+    }
+
+    TileId TextureArray::add_tile(const std::string_view name, const GLuint layer, const glm::vec2& left_bottom_uv, const glm::vec2& right_top_uv){
+        if (layer >= m_layer_count){
+            std::cerr << "TEXTURE ARRAY: Tile " << name << " is in layer " << layer
+                      << " of a " << m_layer_count << "-layer array" << std::endl;
+            return invalid_tile_id;
+        }
+        auto result = m_tile_ids.emplace(ResourceName::registered(name).value(), static_cast<TileId>(m_tiles.size()));
+        if (!result.second){
+            std::cerr << "TEXTURE ARRAY: Tile " << name << " is already in layer " << m_tiles[result.first->second].layer << std::endl;
+            return result.first->second;
+        }
+        const glm::vec2 scale = layer_uv_scale(layer);
+        m_tiles.emplace_back(left_bottom_uv * scale, right_top_uv * scale, layer);
+        return result.first->second;
+    }
+
+    TileId TextureArray::find_tile(const ResourceName name) const{
+        auto it = m_tile_ids.find(name.value());
+        return it != m_tile_ids.end() ? it->second : invalid_tile_id;
+    }
+
+    const TextureArray::Tile& TextureArray::default_tile(){
+        const static Tile tile;
+        return tile;
+    }
+
+    void TextureArray::bind(const GLuint unit) const{
+        StateCache::bind_texture(unit, m_id);
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "tile_id.hpp"
+#include "../resources/resource_name.hpp"
+
+namespace Renderer{
+    // GL_TEXTURE_2D_ARRAY holding one sprite sheet per layer, so sprites from
+    // different sheets share one texture binding and batch into one draw.
+    // Sheets smaller than the array are placed in the bottom left corner of
+    // their layer (padded); their tiles are scaled into that corner.
+    class TextureArray{
+    public:
+        struct Tile{
+            glm::vec2 left_bottom_uv;
+            glm::vec2 right_top_uv;
+            GLuint layer;
+
+            Tile(const glm::vec2& _left_bottom_uv, const glm::vec2& _right_top_uv, const GLuint _layer)
+                : left_bottom_uv(_left_bottom_uv)
+                , right_top_uv(_right_top_uv)
+                , layer(_layer){}
+
+            Tile()
+                : left_bottom_uv(0.0f)
+                , right_top_uv(1.0f)
+                , layer(0){}
+
+            glm::vec4 uv_rect() const {return glm::vec4(left_bottom_uv, right_top_uv);}
+        };
+
+        TextureArray(const GLuint width, const GLuint height, const GLuint layer_count,
+                     const GLenum filter = GL_NEAREST, const GLenum wrap_mode = GL_CLAMP_TO_EDGE);
+        TextureArray() = delete;
+        TextureArray(const TextureArray&) = delete;
+        TextureArray& operator=(const TextureArray&) = delete;
+        ~TextureArray();
+
+        // Uploads a width x height sheet (at most the array's size) into a layer.
+        void set_layer(const GLuint layer, const GLuint width, const GLuint height,
+                       const unsigned char* data, const unsigned int channels = 4);
+        // UVs are relative to the sheet and scaled to where it sits in its layer;
+        // invalid_tile_id for a layer outside the array.
+        TileId add_tile(const std::string_view name, const GLuint layer, const glm::vec2& left_bottom_uv, const glm::vec2& right_top_uv);
+        TileId find_tile(const ResourceName name) const;
+        const Tile& get_tile(const TileId id) const {return id < m_tiles.size() ? m_tiles[id] : default_tile();}
+        const Tile& get_tile(const ResourceName name) const {return get_tile(find_tile(name));}
+        size_t tile_count() const {return m_tiles.size();}
+        // Scale from sheet UVs to layer UVs; 1 for a layer outside the array.
+        glm::vec2 layer_uv_scale(const GLuint layer) const {return layer < m_layer_count ? m_layer_uv_scale[layer] : glm::vec2(1.0f);}
+
+        unsigned int width() const {return m_width;}
+        unsigned int height() const {return m_height;}
+        unsigned int layer_count() const {return m_layer_count;}
+        GLuint id() const {return m_id;}
+        void bind(const GLuint unit = 0) const;
+
+    private:
+        static const Tile& default_tile();
+
+        GLuint m_id = 0;
+        unsigned int m_width;
+        unsigned int m_height;
+        unsigned int m_layer_count;
+        std::vector<glm::vec2> m_layer_uv_scale;
+        std::vector<Tile> m_tiles;
+        std::unordered_map<uint64_t, TileId> m_tile_ids;  // by ResourceName
+    };
+}
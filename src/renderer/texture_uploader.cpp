@@ -0,0 +1,106 @@
+#include <iostream>
+
+#include "texture_2d.hpp"
+#include "texture_uploader.hpp"
+
+namespace Renderer{
+    // PBO offsets only need to be a multiple of the pixel component size; keep staging cache line aligned
+    static const GLintptr staging_alignment = 64;
+
+    TextureUploader::TextureUploader(const GLsizeiptr staging_size)
+                                     : m_size(staging_size){
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCreateBuffers(1, &m_id);
+        glNamedBufferStorage(m_id, m_size, nullptr, flags);
+        m_p_data = static_cast<unsigned char*>(glMapNamedBufferRange(m_id, 0, m_size, flags));
+        if (!m_p_data){
+            std::cerr << "TEXTURE UPLOADER: Can't map " << m_size << " bytes" << std::endl;
+        }
+    }
+
+    TextureUploader::~TextureUploader(){
+        finish();
+        if (m_p_data){
+            glUnmapNamedBuffer(m_id);
+        }
+        glDeleteBuffers(1, &m_id);
+    }
+
+    TextureUploader::Staging TextureUploader::reserve(const GLsizeiptr size){
+        if (!m_p_data || size > m_size){
+            return Staging{nullptr, 0, 0};
+        }
+        poll();
+        bool has_waited = false;
+        while (true){
+            if (m_in_flight.empty()){
+                return Staging{m_p_data, 0, size};
+            }
+            const GLintptr head = (m_head + staging_alignment - 1) / staging_alignment * staging_alignment;
+            // the free space runs from the head to the oldest upload still in flight
+            const GLintptr oldest = m_in_flight.front().begin;
+            if (m_head > oldest){
+                if (head + size <= m_size){
+                    return Staging{m_p_data + head, head, size};
+                }
+                if (size <= oldest){
+                    return Staging{m_p_data, 0, size};
+                }
+            }else if (m_head < oldest && head + size <= oldest){
+                return Staging{m_p_data + head, head, size};
+            }
+            if (!has_waited){
+                ++m_stats.stalls;
+                has_waited = true;
+            }
+            retire_oldest();
+        }
+    }
+
+    void TextureUploader::upload(Texture2D& texture, const Staging& staging){
+        if (m_in_flight.empty()){
+            m_busy_since = std::chrono::steady_clock::now();
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_id);
+        // DSA has no named unpack source: the buffer is bound just for the upload and
+        // the pixel pointer is an offset into it
+        texture.set_pixels(reinterpret_cast<const void*>(staging.offset));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        m_in_flight.push_back(InFlight{staging.offset, staging.offset + staging.size, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+        m_head = staging.offset + staging.size;
+        ++m_stats.uploads;
+        m_stats.bytes += staging.size;
+    }
+
+    void TextureUploader::poll(){
+        while (!m_in_flight.empty() && is_signalled(m_in_flight.front().fence, 0)){
+            retire_oldest();
+        }
+    }
+
+    void TextureUploader::finish(){
+        while (!m_in_flight.empty()){
+            retire_oldest();
+        }
+    }
+
+    bool TextureUploader::is_signalled(const GLsync fence, const GLuint64 timeout){
+        const GLenum result = glClientWaitSync(fence, timeout ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+        if (result == GL_WAIT_FAILED){
+            std::cerr << "TEXTURE UPLOADER: Waiting for the GPU failed" << std::endl;
+        }
+        return result != GL_TIMEOUT_EXPIRED;
+    }
+
+    void TextureUploader::retire_oldest(){
+        const InFlight oldest = m_in_flight.front();
+        while (!is_signalled(oldest.fence, 1000000)){
+        }
+        glDeleteSync(oldest.fence);
+        m_in_flight.pop_front();
+        if (m_in_flight.empty()){
+            m_stats.busy_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_busy_since).count();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+
+#include <glad/glad.h>
+
+namespace Renderer{
+    class Texture2D;
+
+    // Stages texture pixels in a persistently mapped GL_PIXEL_UNPACK_BUFFER ring
+    // and uploads from there, so glTexSubImage2D reads from GPU-visible memory
+    // and returns without copying out of client memory. Every upload is fenced;
+    // space in the ring is reused once the GPU has signalled its fence.
+    class TextureUploader{
+    public:
+        struct Staging{
+            unsigned char* p_data;  // write the pixels here before upload
+            GLintptr offset;
+            GLsizeiptr size;
+            bool is_valid() const {return p_data != nullptr;}
+        };
+
+        struct Stats{
+            size_t uploads = 0;
+            size_t bytes = 0;
+            size_t stalls = 0;          // reserves that had to wait for the GPU
+            double busy_seconds = 0.0;  // time with uploads in flight, as seen by poll/finish
+            double megabytes_per_second() const {return busy_seconds > 0.0 ? bytes / (1024.0 * 1024.0) / busy_seconds : 0.0;}
+        };
+
+        explicit TextureUploader(const GLsizeiptr staging_size = 64 * 1024 * 1024);
+        ~TextureUploader();
+        TextureUploader(const TextureUploader&) = delete;
+        TextureUploader& operator=(const TextureUploader&) = delete;
+
+        // Returns staging memory for size bytes, waiting for earlier uploads if the
+        // ring is full. Invalid if size exceeds the ring; upload from client memory then.
+        Staging reserve(const GLsizeiptr size);
+        // Uploads the whole texture from the last reserved staging memory.
+        void upload(Texture2D& texture, const Staging& staging);
+        // Releases the staging memory of uploads the GPU has finished.
+        void poll();
+        // Waits for every upload in flight.
+        void finish();
+
+        const Stats& stats() const {return m_stats;}
+
+    private:
+        struct InFlight{
+            GLintptr begin;
+            GLintptr end;
+            GLsync fence;
+        };
+
+        bool is_signalled(const GLsync fence, const GLuint64 timeout);
+        void retire_oldest();
+
+        GLuint m_id = 0;
+        unsigned char* m_p_data = nullptr;
+        GLsizeiptr m_size;
+        GLintptr m_head = 0;
+        std::deque<InFlight> m_in_flight;
+        std::chrono::steady_clock::time_point m_busy_since;
+        Stats m_stats;
+    };
+}
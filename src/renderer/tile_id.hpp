@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Renderer{
+    // Index of a tile in the tile table of a Texture2D or TextureArray. Resolve
+    // it once from the tile name with find_tile, then look tiles up by id.
+    typedef uint32_t TileId;
+    // Returned for unknown names; get_tile maps it to the whole texture.
+    const TileId invalid_tile_id = UINT32_MAX;
+}
@@ -0,0 +1,244 @@
+#include <cmath>
+
+#include <glm/trigonometric.hpp>
+
+#include "transform_store.hpp"
+
+// glm only enables its own SIMD layer with GLM_FORCE_INTRINSICS, which would
+// change the layout of glm types for the whole project, so the kernel uses
+// the intrinsics directly. Build with PRACTICE_ENABLE_AVX2 for the 8-wide path.
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRANSFORM_STORE_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRANSFORM_STORE_LANES 4
+#endif
+
+namespace{
+#if TRANSFORM_STORE_LANES == 8
+    typedef __m256 Lanes;
+    inline Lanes simd_load(const float* p){return _mm256_loadu_ps(p);}
+    inline Lanes simd_broadcast(const float v){return _mm256_set1_ps(v);}
+    inline Lanes simd_add(const Lanes a, const Lanes b){return _mm256_add_ps(a, b);}
+    inline Lanes simd_sub(const Lanes a, const Lanes b){return _mm256_sub_ps(a, b);}
+    inline Lanes simd_mul(const Lanes a, const Lanes b){return _mm256_mul_ps(a, b);}
+#elif TRANSFORM_STORE_LANES == 4
+    typedef __m128 Lanes;
+    inline Lanes simd_load(const float* p){return _mm_loadu_ps(p);}
+    inline Lanes simd_broadcast(const float v){return _mm_set1_ps(v);}
+    inline Lanes simd_add(const Lanes a, const Lanes b){return _mm_add_ps(a, b);}
+    inline Lanes simd_sub(const Lanes a, const Lanes b){return _mm_sub_ps(a, b);}
+    inline Lanes simd_mul(const Lanes a, const Lanes b){return _mm_mul_ps(a, b);}
+#endif
+
+#ifdef TRANSFORM_STORE_LANES
+    static_assert(sizeof(Renderer::SpriteBatch::Vertex) == 6 * sizeof(float), "store_quads writes packed vertices");
+
+    // Writes the 16 vertices of 4 sprites. corners holds c0x, c0y, .. c3y with
+    // one sprite per lane; they are transposed in registers and interleaved with
+    // layer, uv and texture layer so every store writes 4 floats of finished vertex.
+    inline void store_quads(float* p_out, const __m128 (&corners)[8],
+                            const float* p_layer, const glm::vec4* p_uv, const float* p_texture_layer){
+        __m128 near_x = corners[0], near_y = corners[1], near_x1 = corners[2], near_y1 = corners[3];
+        __m128 far_x = corners[4], far_y = corners[5], far_x1 = corners[6], far_y1 = corners[7];
+        // rows become per sprite: [c0x c0y c1x c1y] and [c2x c2y c3x c3y]
+        _MM_TRANSPOSE4_PS(near_x, near_y, near_x1, near_y1);
+        _MM_TRANSPOSE4_PS(far_x, far_y, far_x1, far_y1);
+        const __m128 near[4] = {near_x, near_y, near_x1, near_y1};
+        const __m128 far[4] = {far_x, far_y, far_x1, far_y1};
+        const __m128 layers = _mm_loadu_ps(p_layer);
+        const __m128 texture_layers = _mm_loadu_ps(p_texture_layer);
+        const __m128 low = _mm_unpacklo_ps(layers, texture_layers);
+        const __m128 high = _mm_unpackhi_ps(layers, texture_layers);
+        // [z t z t] per sprite
+        const __m128 zt[4] = {_mm_movelh_ps(low, low), _mm_movehl_ps(low, low), _mm_movelh_ps(high, high), _mm_movehl_ps(high, high)};
+        for (int k = 0; k < 4; ++k){
+            const __m128 uv = _mm_loadu_ps(&p_uv[k].x);                    // ux uy uz uw
+            const __m128 zu_lo = _mm_unpacklo_ps(zt[k], uv);               // z ux t uy
+            const __m128 zu_hi = _mm_unpackhi_ps(uv, zt[k]);               // uz z uw t
+            float* p = p_out + k * 24;
+            _mm_storeu_ps(p, _mm_movelh_ps(near[k], zu_lo));                                  // c0x c0y z ux
+            _mm_storeu_ps(p + 4, _mm_shuffle_ps(zu_lo, near[k], _MM_SHUFFLE(3, 2, 2, 3)));   // uy t c1x c1y
+            _mm_storeu_ps(p + 8, _mm_shuffle_ps(zu_lo, zu_hi, _MM_SHUFFLE(3, 2, 1, 0)));     // z ux uw t
+            _mm_storeu_ps(p + 12, _mm_shuffle_ps(far[k], zu_hi, _MM_SHUFFLE(0, 1, 1, 0)));   // c2x c2y z uz
+            _mm_storeu_ps(p + 16, _mm_shuffle_ps(zu_hi, far[k], _MM_SHUFFLE(3, 2, 3, 2)));   // uw t c3x c3y
+            _mm_storeu_ps(p + 20, _mm_shuffle_ps(zu_hi, zu_lo, _MM_SHUFFLE(2, 3, 0, 1)));    // z uz uy t
+        }
+    }
+
+#if TRANSFORM_STORE_LANES == 8
+    inline void store_quads(float* p_out, const __m256 (&corners)[8],
+                            const float* p_layer, const glm::vec4* p_uv, const float* p_texture_layer){
+        __m128 low[8];
+        __m128 high[8];
+        for (int c = 0; c < 8; ++c){
+            low[c] = _mm256_castps256_ps128(corners[c]);
+            high[c] = _mm256_extractf128_ps(corners[c], 1);
+        }
+        store_quads(p_out, low, p_layer, p_uv, p_texture_layer);
+        store_quads(p_out + 4 * 24, high, p_layer + 4, p_uv + 4, p_texture_layer + 4);
+    }
+#endif
+#endif
+
+    inline void write_vertices(Renderer::SpriteBatch::Vertex* p_out,
+                               const float c0x, const float c0y, const float c1x, const float c1y,
+                               const float c2x, const float c2y, const float c3x, const float c3y,
+                               const float z, const glm::vec4& uv, const float texture_layer){
+        p_out[0].position = glm::vec3(c0x, c0y, z);
+        p_out[1].position = glm::vec3(c1x, c1y, z);
+        p_out[2].position = glm::vec3(c2x, c2y, z);
+        p_out[3].position = glm::vec3(c3x, c3y, z);
+        p_out[0].uv = glm::vec2(uv.x, uv.y);
+        p_out[1].uv = glm::vec2(uv.x, uv.w);
+        p_out[2].uv = glm::vec2(uv.z, uv.w);
+        p_out[3].uv = glm::vec2(uv.z, uv.y);
+        p_out[0].texture_layer = texture_layer;
+        p_out[1].texture_layer = texture_layer;
+        p_out[2].texture_layer = texture_layer;
+        p_out[3].texture_layer = texture_layer;
+    }
+}
+
+namespace Renderer{
+    TransformStore::Index TransformStore::add(const glm::vec2& position,
+                                              const glm::vec2& size,
+                                              const float rotation,
+                                              const glm::vec4& uv_rect,
+                                              const float layer,
+                                              const float texture_layer){
+        const Index index = static_cast<Index>(m_x.size());
+        m_x.push_back(position.x);
+        m_y.push_back(position.y);
+        m_width.push_back(size.x);
+        m_height.push_back(size.y);
+        m_rotation.push_back(0.0f);
+        m_cos.push_back(1.0f);
+        m_sin.push_back(0.0f);
+        m_layer.push_back(layer);
+        m_uv_rect.push_back(uv_rect);
+        m_texture_layer.push_back(texture_layer);
+        set_rotation(index, rotation);
+        return index;
+    }
+
+    void TransformStore::clear(){
+        m_x.clear();
+        m_y.clear();
+        m_width.clear();
+        m_height.clear();
+        m_rotation.clear();
+        m_cos.clear();
+        m_sin.clear();
+        m_layer.clear();
+        m_uv_rect.clear();
+        m_texture_layer.clear();
+    }
+
+    void TransformStore::reserve(const size_t count){
+        m_x.reserve(count);
+        m_y.reserve(count);
+        m_width.reserve(count);
+        m_height.reserve(count);
+        m_rotation.reserve(count);
+        m_cos.reserve(count);
+        m_sin.reserve(count);
+        m_layer.reserve(count);
+        m_uv_rect.reserve(count);
+        m_texture_layer.reserve(count);
+    }
+
+    void TransformStore::set_position(const Index index, const glm::vec2& position){
+        m_x[index] = position.x;
+        m_y[index] = position.y;
+    }
+
+    void TransformStore::set_size(const Index index, const glm::vec2& size){
+        m_width[index] = size.x;
+        m_height[index] = size.y;
+    }
+
+    void TransformStore::set_rotation(const Index index, const float rotation){
+        m_rotation[index] = rotation;
+        m_cos[index] = rotation == 0.0f ? 1.0f : std::cos(glm::radians(rotation));
+        m_sin[index] = rotation == 0.0f ? 0.0f : std::sin(glm::radians(rotation));
+    }
+
+    void TransformStore::set_uv_rect(const Index index, const glm::vec4& uv_rect){
+        m_uv_rect[index] = uv_rect;
+    }
+
+    void TransformStore::set_texture_layer(const Index index, const float texture_layer){
+        m_texture_layer[index] = texture_layer;
+    }
+
+    // Same transform as SpriteBatch::write_quad: with hw = w / 2, hh = h / 2 the
+    // pivot is (x + hw, y - hh) and the corners are, relative to it,
+    // (-hw, hh), (-hw, 3 hh), (hw, 3 hh), (hw, hh) rotated by (cos, sin).
+    void TransformStore::write_quads_scalar(SpriteBatch::Vertex* p_out, const size_t first, const size_t count) const{
+        for (size_t i = first; i < first + count; ++i){
+            const float hw = 0.5f * m_width[i];
+            const float hh = 0.5f * m_height[i];
+            const float px = m_x[i] + hw;
+            const float py = m_y[i] - hh;
+            const float a = m_cos[i] * hw;
+            const float b = m_sin[i] * hw;
+            const float d = m_sin[i] * hh;
+            const float e = m_cos[i] * hh;
+            write_vertices(p_out + (i - first) * 4,
+                           px - a - d, py - b + e,
+                           px - a - 3.0f * d, py - b + 3.0f * e,
+                           px + a - 3.0f * d, py + b + 3.0f * e,
+                           px + a - d, py + b + e,
+                           m_layer[i], m_uv_rect[i], m_texture_layer[i]);
+        }
+    }
+
+    void TransformStore::write_quads(SpriteBatch::Vertex* p_out, const size_t first, const size_t count) const{
+        size_t i = first;
+#ifdef TRANSFORM_STORE_LANES
+        const size_t lanes = TRANSFORM_STORE_LANES;
+        const Lanes half = simd_broadcast(0.5f);
+        const Lanes three = simd_broadcast(3.0f);
+        for (; i + lanes <= first + count; i += lanes){
+            const Lanes hw = simd_mul(simd_load(&m_width[i]), half);
+            const Lanes hh = simd_mul(simd_load(&m_height[i]), half);
+            const Lanes c = simd_load(&m_cos[i]);
+            const Lanes s = simd_load(&m_sin[i]);
+            const Lanes px = simd_add(simd_load(&m_x[i]), hw);
+            const Lanes py = simd_sub(simd_load(&m_y[i]), hh);
+            const Lanes a = simd_mul(c, hw);
+            const Lanes b = simd_mul(s, hw);
+            const Lanes d = simd_mul(s, hh);
+            const Lanes e = simd_mul(c, hh);
+            const Lanes d3 = simd_mul(d, three);
+            const Lanes e3 = simd_mul(e, three);
+            const Lanes left = simd_sub(px, a);
+            const Lanes right = simd_add(px, a);
+            const Lanes bottom = simd_sub(py, b);
+            const Lanes top = simd_add(py, b);
+            const Lanes corners[8] = {
+                simd_sub(left, d), simd_add(bottom, e),
+                simd_sub(left, d3), simd_add(bottom, e3),
+                simd_sub(right, d3), simd_add(top, e3),
+                simd_sub(right, d), simd_add(top, e)};
+            store_quads(reinterpret_cast<float*>(p_out + (i - first) * 4), corners,
+                        &m_layer[i], &m_uv_rect[i], &m_texture_layer[i]);
+        }
+#endif
+        write_quads_scalar(p_out + (i - first) * 4, i, first + count - i);
+    }
+
+    void TransformStore::write_instances(SpriteInstance* p_out, const size_t first, const size_t count) const{
+        for (size_t i = first; i < first + count; ++i){
+            SpriteInstance& instance = p_out[i - first];
+            instance.position = glm::vec2(m_x[i], m_y[i]);
+            instance.size = glm::vec2(m_width[i], m_height[i]);
+            instance.rotation = m_rotation[i];
+            instance.layer = m_layer[i];
+            instance.uv_rect = m_uv_rect[i];
+            instance.texture_layer = m_texture_layer[i];
+        }
+    }
+}
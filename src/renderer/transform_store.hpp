@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "sprite_batch.hpp"
+
+namespace Renderer{
+    // Structure-of-arrays storage for large sprite populations. Transforms are
+    // kept in separate arrays (with the rotation's cos/sin cached on write) so
+    // write_quads can expand several sprites per SSE/AVX instruction straight
+    // into a SpriteBatch vertex buffer.
+    class TransformStore{
+    public:
+        typedef uint32_t Index;
+
+        Index add(const glm::vec2& position,
+                  const glm::vec2& size,
+                  const float rotation = 0.0f,
+                  const glm::vec4& uv_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+                  const float layer = 0.0f,
+                  const float texture_layer = 0.0f);
+        void clear();
+        void reserve(const size_t count);
+        size_t size() const {return m_x.size();}
+
+        void set_position(const Index index, const glm::vec2& position);
+        void set_size(const Index index, const glm::vec2& size);
+        void set_rotation(const Index index, const float rotation);
+        void set_uv_rect(const Index index, const glm::vec4& uv_rect);
+        void set_texture_layer(const Index index, const float texture_layer);
+        glm::vec2 position(const Index index) const {return glm::vec2(m_x[index], m_y[index]);}
+        // The uv_rect column, for systems that write it in bulk (AnimationSystem).
+        glm::vec4* uv_rects() {return m_uv_rect.data();}
+
+        // Writes count * 4 vertices for sprites [first, first + count).
+        void write_quads(SpriteBatch::Vertex* p_out, const size_t first, const size_t count) const;
+        void write_quads_scalar(SpriteBatch::Vertex* p_out, const size_t first, const size_t count) const;
+        void write_instances(SpriteInstance* p_out, const size_t first, const size_t count) const;
+
+    private:
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_width;
+        std::vector<float> m_height;
+        std::vector<float> m_rotation;
+        std::vector<float> m_cos;
+        std::vector<float> m_sin;
+        std::vector<float> m_layer;
+        std::vector<glm::vec4> m_uv_rect;
+        std::vector<float> m_texture_layer;
+    };
+}
@@ -0,0 +1,136 @@
+#include "asset_pack.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+AssetPack::AssetPack(const std::string& path)
+    : m_file(path){
+    if (!m_file.is_open()){
+        return;
+    }
+    if (m_file.size() < sizeof(Header)){
+        std::cerr << "Asset pack is truncated: " << path << std::endl;
+        return;
+    }
+    Header header;
+    std::memcpy(&header, m_file.data(), sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version){
+        std::cerr << "Not an asset pack or unsupported version: " << path << std::endl;
+        return;
+    }
+    const uint64_t file_size = m_file.size();
+    if (header.entries_offset > file_size ||
+        header.entry_count > (file_size - header.entries_offset) / sizeof(Entry) ||
+        header.names_offset > file_size || header.names_size > file_size - header.names_offset){
+        std::cerr << "Asset pack is truncated: " << path << std::endl;
+        return;
+    }
+    // the mapping is page aligned, so an aligned offset gives an aligned Entry table
+    if (header.entries_offset % alignof(Entry) != 0){
+        std::cerr << "Asset pack entry table is misaligned: " << path << std::endl;
+        return;
+    }
+    m_p_entries = reinterpret_cast<const Entry*>(m_file.data() + header.entries_offset);
+    m_entry_count = header.entry_count;
+    m_p_names = reinterpret_cast<const char*>(m_file.data() + header.names_offset);
+    m_names_size = header.names_size;
+    // every entry is checked once here so name, data and the atlas readers can trust it
+    for (size_t i = 0; i < m_entry_count; ++i){
+        if (!is_entry_valid(m_p_entries[i])){
+            std::cerr << "Asset pack entry " << i << " is corrupt: " << path << std::endl;
+            m_p_entries = nullptr;
+            m_entry_count = 0;
+            m_p_names = nullptr;
+            return;
+        }
+    }
+    m_is_open = true;
+}
+
+bool AssetPack::is_entry_valid(const Entry& entry) const{
+    const uint64_t file_size = m_file.size();
+    if (entry.offset % blob_alignment != 0 || entry.offset > file_size || entry.size > file_size - entry.offset ||
+        entry.name_offset > m_names_size || entry.name_length > m_names_size - entry.name_offset){
+        return false;
+    }
+    if (entry.type == Type::Texture){
+        return entry.channels >= 1 && entry.channels <= 4 &&
+               entry.size == static_cast<uint64_t>(entry.width) * entry.height * entry.channels;
+    }
+    if (entry.type == Type::Atlas){
+        if (entry.size < sizeof(AtlasHeader)){
+            return false;
+        }
+        const unsigned char* p_blob = m_file.data() + entry.offset;
+        AtlasHeader header;
+        std::memcpy(&header, p_blob, sizeof(header));
+        const uint64_t tiles_end = sizeof(AtlasHeader) + static_cast<uint64_t>(header.tile_count) * sizeof(AtlasTile);
+        if (tiles_end > entry.size ||
+            header.texture_name_offset > entry.size || header.texture_name_length > entry.size - header.texture_name_offset){
+            return false;
+        }
+        for (uint32_t i = 0; i < header.tile_count; ++i){
+            AtlasTile tile;
+            std::memcpy(&tile, p_blob + sizeof(AtlasHeader) + i * sizeof(AtlasTile), sizeof(tile));
+            if (tile.name_offset > entry.size || tile.name_length > entry.size - tile.name_offset){
+                return false;
+            }
+        }
+        return true;
+    }
+    return entry.type == Type::Raw;
+}
+
+const AssetPack::Entry* AssetPack::find(const std::string_view name, const Type type) const{
+    const std::string key = normalize_name(name);
+    const Entry* p_end = m_p_entries + m_entry_count;
+    const Entry* p_entry = std::lower_bound(m_p_entries, p_end, key, [this](const Entry& entry, const std::string& key){
+        return this->name(entry) < key;
+    });
+    if (p_entry == p_end || this->name(*p_entry) != key || p_entry->type != type){
+        return nullptr;
+    }
+    return p_entry;
+}
+
+std::string_view AssetPack::name(const Entry& entry) const{
+    return std::string_view(m_p_names + entry.name_offset, entry.name_length);
+}
+
+std::string_view AssetPack::data(const Entry& entry) const{
+    // bounds were checked when the pack was opened
+    return std::string_view(reinterpret_cast<const char*>(m_file.data()) + entry.offset, entry.size);
+}
+
+std::string AssetPack::normalize_name(const std::string_view name){
+    return std::filesystem::path(name).lexically_normal().generic_string();
+}
+
+bool parse_atlas_manifest(const std::string_view text, AtlasManifest& manifest){
+    std::istringstream stream{std::string(text)};
+    if (!(stream >> manifest.texture_path >> manifest.tile_width >> manifest.tile_height) ||
+        manifest.tile_width == 0 || manifest.tile_height == 0){
+        return false;
+    }
+    manifest.tiles.clear();
+    std::string tile;
+    while (stream >> tile){
+        manifest.tiles.push_back(tile);
+    }
+    return true;
+}
+
+void grid_tile_uv(const unsigned int texture_width, const unsigned int texture_height,
+                  const unsigned int tile_width, const unsigned int tile_height,
+                  const size_t tile_index, glm::vec2& left_bottom_uv, glm::vec2& right_top_uv){
+    const size_t tiles_per_row = std::max<size_t>(1, (texture_width + tile_width - 1) / tile_width);
+    const unsigned int tile_offset_x = static_cast<unsigned int>(tile_index % tiles_per_row) * tile_width;
+    const unsigned int tile_offset_y = texture_height - static_cast<unsigned int>(tile_index / tiles_per_row) * tile_height;
+    left_bottom_uv = glm::vec2(static_cast<float>(tile_offset_x) / texture_width,
+                               static_cast<float>(tile_offset_y - tile_height) / texture_height);
+    right_top_uv = glm::vec2(static_cast<float>(tile_offset_x + tile_width) / texture_width,
+                             static_cast<float>(tile_offset_y) / texture_height);
+}
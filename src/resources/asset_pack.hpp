@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "mapped_file.hpp"
+
+// Read side of the asset pack written by tools/asset_packer.cpp. The pack is
+// mapped once and every asset is served as a view into the mapping:
+//
+// Header | blobs, each aligned to blob_alignment | Entry table sorted by name | names
+//
+// Raw entries hold file contents (shaders), Texture entries hold decoded
+// pixels flipped for GL, Atlas entries hold a tile table built from a
+// *.atlas manifest.
+class AssetPack{
+public:
+    static constexpr char magic[4] = {'D', 'N', 'P', 'K'};
+    static constexpr uint32_t version = 1;
+    static constexpr uint64_t blob_alignment = 64;
+
+    enum class Type : uint32_t{
+        Raw,
+        Texture,
+        Atlas
+    };
+
+    struct Header{
+        char magic[4];
+        uint32_t version;
+        uint32_t entry_count;
+        uint32_t names_size;
+        uint64_t entries_offset;
+        uint64_t names_offset;
+    };
+
+    struct Entry{
+        uint64_t offset;
+        uint64_t size;
+        uint32_t name_offset;
+        uint32_t name_length;
+        Type type;
+        uint32_t width;     // textures only
+        uint32_t height;
+        uint32_t channels;
+    };
+
+    // Atlas blob: AtlasHeader | AtlasTile[tile_count] | characters; the
+    // string offsets are relative to the start of the blob.
+    struct AtlasHeader{
+        uint32_t tile_count;
+        uint32_t texture_name_offset;
+        uint32_t texture_name_length;
+    };
+
+    struct AtlasTile{
+        float left_bottom_uv[2];
+        float right_top_uv[2];
+        uint32_t name_offset;
+        uint32_t name_length;
+    };
+
+    explicit AssetPack(const std::string& path);
+
+    bool is_open() const {return m_is_open;}
+    size_t entry_count() const {return m_entry_count;}
+    // Finds an entry by its path relative to the directory the pack was built from, e.g. "res/shaders/sprite.vert".
+    const Entry* find(const std::string_view name, const Type type) const;
+    std::string_view name(const Entry& entry) const;
+    std::string_view data(const Entry& entry) const;
+
+    static std::string normalize_name(const std::string_view name);
+
+private:
+    // Checks that the entry's blob is aligned, that it and the name lie inside
+    // the pack, and that texture sizes and atlas tables are consistent.
+    bool is_entry_valid(const Entry& entry) const;
+
+    MappedFile m_file;
+    const Entry* m_p_entries = nullptr;
+    size_t m_entry_count = 0;
+    const char* m_p_names = nullptr;
+    uint64_t m_names_size = 0;
+    bool m_is_open = false;
+};
+
+// Text manifest describing a grid atlas, shared by the packer and the loose-file path:
+//   <texture path relative to the manifest>
+//   <tile width> <tile height>
+//   <tile names, whitespace separated, row by row from the top left>
+struct AtlasManifest{
+    std::string texture_path;
+    unsigned int tile_width = 0;
+    unsigned int tile_height = 0;
+    std::vector<std::string> tiles;
+};
+
+bool parse_atlas_manifest(const std::string_view text, AtlasManifest& manifest);
+// UV rect of the tile_index-th tile of a grid laid out from the top left.
+void grid_tile_uv(const unsigned int texture_width, const unsigned int texture_height,
+                  const unsigned int tile_width, const unsigned int tile_height,
+                  const size_t tile_index, glm::vec2& left_bottom_uv, glm::vec2& right_top_uv);
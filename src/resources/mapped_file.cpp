@@ -0,0 +1,117 @@
+#include "mapped_file.hpp"
+
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path){
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE){
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return;
+    }
+    m_file = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)){
+        std::cerr << "Failed to get the size of file: " << path << std::endl;
+        close();
+        return;
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_is_open = true;
+    // an empty file can't be mapped, it is just an empty view
+    if (m_size == 0){
+        return;
+    }
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping){
+        m_p_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0){
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return;
+    }
+    struct stat status;
+    if (fstat(file, &status) != 0){
+        std::cerr << "Failed to get the size of file: " << path << std::endl;
+        ::close(file);
+        return;
+    }
+    m_size = static_cast<size_t>(status.st_size);
+    m_is_open = true;
+    // an empty file can't be mapped, it is just an empty view
+    if (m_size == 0){
+        ::close(file);
+        return;
+    }
+    void* p_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    // the mapping keeps its own reference to the file
+    ::close(file);
+    if (p_data != MAP_FAILED){
+        m_p_data = static_cast<const unsigned char*>(p_data);
+        madvise(p_data, m_size, MADV_SEQUENTIAL);
+    }
+#endif
+    if (!m_p_data){
+        std::cerr << "Failed to map file: " << path << std::endl;
+        close();
+    }
+}
+
+MappedFile::~MappedFile(){
+    close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& mapped_file) noexcept{
+    if (this != &mapped_file){
+        close();
+        m_p_data = std::exchange(mapped_file.m_p_data, nullptr);
+        m_size = std::exchange(mapped_file.m_size, 0);
+        m_is_open = std::exchange(mapped_file.m_is_open, false);
+#ifdef _WIN32
+        m_file = std::exchange(mapped_file.m_file, nullptr);
+        m_mapping = std::exchange(mapped_file.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::MappedFile(MappedFile&& mapped_file) noexcept{
+    *this = std::move(mapped_file);
+}
+
+void MappedFile::close(){
+#ifdef _WIN32
+    if (m_p_data){
+        UnmapViewOfFile(m_p_data);
+    }
+    if (m_mapping){
+        CloseHandle(m_mapping);
+    }
+    if (m_file){
+        CloseHandle(m_file);
+    }
+    m_file = nullptr;
+    m_mapping = nullptr;
+#else
+    if (m_p_data){
+        munmap(const_cast<unsigned char*>(m_p_data), m_size);
+    }
+#endif
+    m_p_data = nullptr;
+    m_size = 0;
+    m_is_open = false;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only view of a whole file. The file is memory mapped, so the bytes are
+// never copied into a buffer of ours; views returned by view() stay valid for
+// as long as the MappedFile lives.
+class MappedFile{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& mapped_file) noexcept;
+    MappedFile(MappedFile&& mapped_file) noexcept;
+
+    bool is_open() const {return m_is_open;}
+    const unsigned char* data() const {return m_p_data;}
+    size_t size() const {return m_size;}
+    std::string_view view() const {return std::string_view(reinterpret_cast<const char*>(m_p_data), m_size);}
+
+private:
+    void close();
+
+    const unsigned char* m_p_data = nullptr;
+    size_t m_size = 0;
+    bool m_is_open = false;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
@@ -0,0 +1,15 @@
+#include "name_table.hpp"
+
+NameId NameTable::intern(const std::string_view name){
+    const ResourceName resource_name = ResourceName::registered(name);
+    auto result = m_ids.emplace(resource_name.value(), static_cast<NameId>(m_names.size()));
+    if (result.second){
+        m_names.emplace_back(name);
+    }
+    return result.first->second;
+}
+
+NameId NameTable::find(const ResourceName name) const{
+    auto it = m_ids.find(name.value());
+    return it != m_ids.end() ? it->second : invalid_name_id;
+}
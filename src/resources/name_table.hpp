@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "resource_name.hpp"
+
+// Dense id of an interned name; ids start at 0 and are never reused.
+typedef uint32_t NameId;
+const NameId invalid_name_id = UINT32_MAX;
+
+// Interns resource names so each distinct string is stored and hashed once;
+// registries are then indexed by the compact NameId instead of the string.
+class NameTable{
+public:
+    NameId intern(const std::string_view name);
+    // One probe by the name's hash; invalid_name_id if it was never interned.
+    NameId find(const ResourceName name) const;
+    const std::string& name(const NameId id) const {return m_names[id];}
+    size_t size() const {return m_names.size();}
+
+private:
+    std::vector<std::string> m_names;
+    std::unordered_map<uint64_t, NameId> m_ids;
+};
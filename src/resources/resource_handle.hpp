@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "name_table.hpp"
+
+namespace Renderer{
+    class ShaderProgram;
+    class Texture2D;
+    class TextureArray;
+    class Sprite;
+}
+
+// Slot index plus the generation the slot had when the resource was added.
+// Once the resource is removed the slot's generation moves on, so a stale
+// handle resolves to null instead of to whatever reuses the slot.
+template<typename Resource>
+struct ResourceHandle{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool is_valid() const {return index != UINT32_MAX;}
+    bool operator==(const ResourceHandle& other) const {return index == other.index && generation == other.generation;}
+    bool operator!=(const ResourceHandle& other) const {return !(*this == other);}
+};
+
+typedef ResourceHandle<Renderer::ShaderProgram> ShaderHandle;
+typedef ResourceHandle<Renderer::Texture2D> TextureHandle;
+typedef ResourceHandle<Renderer::TextureArray> TextureArrayHandle;
+typedef ResourceHandle<Renderer::Sprite> SpriteHandle;
+
+// Dense array of resources addressed by ResourceHandle; freed slots are reused.
+template<typename Resource>
+class SlotArray{
+public:
+    typedef ResourceHandle<Resource> Handle;
+
+    Handle add(std::shared_ptr<Resource> p_resource){
+        Handle handle;
+        if (m_free_slots.empty()){
+            handle.index = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }else{
+            handle.index = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+        Slot& slot = m_slots[handle.index];
+        slot.p_resource = std::move(p_resource);
+        handle.generation = slot.generation;
+        return handle;
+    }
+
+    // Returns the removed resource, null for a stale handle.
+    std::shared_ptr<Resource> remove(const Handle handle){
+        if (!get(handle)){
+            return nullptr;
+        }
+        Slot& slot = m_slots[handle.index];
+        ++slot.generation;
+        m_free_slots.push_back(handle.index);
+        return std::move(slot.p_resource);
+    }
+
+    // An index and a generation compare; no reference count is touched.
+    Resource* get(const Handle handle) const{
+        if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation){
+            return nullptr;
+        }
+        return m_slots[handle.index].p_resource.get();
+    }
+
+    const std::shared_ptr<Resource>& get_shared(const Handle handle) const{
+        static const std::shared_ptr<Resource> null_resource;
+        if (!get(handle)){
+            return null_resource;
+        }
+        return m_slots[handle.index].p_resource;
+    }
+
+    size_t size() const {return m_slots.size() - m_free_slots.size();}
+
+private:
+    struct Slot{
+        std::shared_ptr<Resource> p_resource;
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free_slots;
+};
+
+// Resources of one type in a SlotArray, with their handles indexed by the
+// NameId they were registered under.
+template<typename Resource>
+class ResourceRegistry{
+public:
+    typedef ResourceHandle<Resource> Handle;
+
+    // Keeps the resource already registered under the name, like map::emplace.
+    const std::shared_ptr<Resource>& add(const NameId name, std::shared_ptr<Resource> p_resource){
+        if (name >= m_handles.size()){
+            m_handles.resize(name + 1);
+        }
+        Handle& handle = m_handles[name];
+        if (!m_slots.get(handle)){
+            handle = m_slots.add(std::move(p_resource));
+        }
+        return m_slots.get_shared(handle);
+    }
+
+    std::shared_ptr<Resource> remove(const NameId name){
+        const Handle handle = find(name);
+        if (handle.is_valid()){
+            m_handles[name] = Handle();
+        }
+        return m_slots.remove(handle);
+    }
+
+    Handle find(const NameId name) const {return name < m_handles.size() ? m_handles[name] : Handle();}
+    Resource* get(const Handle handle) const {return m_slots.get(handle);}
+    const std::shared_ptr<Resource>& get_shared(const Handle handle) const {return m_slots.get_shared(handle);}
+    size_t size() const {return m_slots.size();}
+
+private:
+    SlotArray<Resource> m_slots;
+    std::vector<Handle> m_handles;
+};
@@ -0,0 +1,41 @@
+#include "resource_name.hpp"
+
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#ifndef NDEBUG
+namespace{
+    std::mutex names_mutex;
+    std::unordered_map<uint64_t, std::string> names_by_hash;
+}
+#endif
+
+ResourceName ResourceName::registered(const std::string_view name){
+    const ResourceName resource_name(name);
+#ifndef NDEBUG
+    std::lock_guard<std::mutex> lock(names_mutex);
+    auto result = names_by_hash.emplace(resource_name.value(), name);
+    if (!result.second && result.first->second != name){
+        std::cerr << "RESOURCE NAME: " << name << " and " << result.first->second
+                  << " have the same hash " << std::hex << resource_name.value() << std::dec << std::endl;
+    }
+#endif
+    return resource_name;
+}
+
+std::string ResourceName::str() const{
+#ifndef NDEBUG
+    {
+        std::lock_guard<std::mutex> lock(names_mutex);
+        auto it = names_by_hash.find(m_hash);
+        if (it != names_by_hash.end()){
+            return it->second;
+        }
+    }
+#endif
+    std::ostringstream stream;
+    stream << "#" << std::hex << m_hash;
+    return stream.str();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// 64-bit FNV-1a hash of a resource or tile name. Registries are keyed by the
+// hash, so a lookup is one integer probe; a constexpr ResourceName built from
+// a literal is hashed at compile time:
+//
+//     constexpr ResourceName grass("grass");
+//
+// Debug builds remember the string behind every registered hash to report
+// collisions and to print names in error messages.
+class ResourceName{
+public:
+    constexpr ResourceName(const std::string_view name) : m_hash(hash(name)) {}
+    constexpr ResourceName(const char* name) : m_hash(hash(name)) {}
+    ResourceName(const std::string& name) : m_hash(hash(name)) {}
+
+    // Hash of a name being registered; in debug builds checks it against every
+    // other registered name.
+    static ResourceName registered(const std::string_view name);
+
+    static constexpr uint64_t hash(const std::string_view name){
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const char c : name){
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    constexpr uint64_t value() const {return m_hash;}
+    constexpr bool operator==(const ResourceName other) const {return m_hash == other.m_hash;}
+    constexpr bool operator!=(const ResourceName other) const {return m_hash != other.m_hash;}
+    // The registered name in debug builds, the hash in hex otherwise.
+    std::string str() const;
+
+private:
+    uint64_t m_hash;
+};
@@ -1,47 +1,120 @@
 #include "resources_manager.hpp"
+#include "mapped_file.hpp"
+#include "asset_pack.hpp"
+#include "thread_pool.hpp"
 #include "../renderer/shader.hpp"
 #include "../renderer/texture_2d.hpp"
 #include "../renderer/sprite.hpp"
+#include "../renderer/quad_geometry.hpp"
+#include "../renderer/texture_uploader.hpp"
+#include "../renderer/texture_array.hpp"
+#include "../renderer/dynamic_atlas.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_ONLY_PNG
 #include "stb_image.h"
 
-#include <sstream>
-#include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <chrono>
+
+namespace{
+    // 64-bit multiply-xorshift hash over 8-byte words; includes the image shape so
+    // equal bytes with different dimensions don't alias.
+    uint64_t hash_pixels(const unsigned char* pixels, const int width, const int height, const int channels){
+        const uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+        uint64_t hash = (static_cast<uint64_t>(width) << 40) ^ (static_cast<uint64_t>(height) << 8) ^ static_cast<uint64_t>(channels);
+        const size_t size = static_cast<size_t>(width) * height * channels;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8){
+            uint64_t word;
+            std::memcpy(&word, pixels + i, sizeof(word));
+            hash = (hash ^ word) * multiplier;
+            hash ^= hash >> 29;
+        }
+        for (; i < size; ++i){
+            hash = (hash ^ pixels[i]) * multiplier;
+        }
+        return hash ^ (hash >> 32);
+    }
+
+    // Decodes the file again and compares it with pixels; a hash match alone
+    // could alias two different images.
+    bool has_same_pixels(const std::string& full_path, const unsigned char* pixels, const int width, const int height, const int channels){
+        const MappedFile file(full_path);
+        int resident_width = 0;
+        int resident_height = 0;
+        int resident_channels = 0;
+        unsigned char* resident_pixels = file.size() == 0 ? nullptr : stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &resident_width, &resident_height, &resident_channels, 0);
+        if (!resident_pixels){
+            return false;
+        }
+        const bool is_same = resident_width == width && resident_height == height && resident_channels == channels &&
+                             std::memcmp(resident_pixels, pixels, static_cast<size_t>(width) * height * channels) == 0;
+        stbi_image_free(resident_pixels);
+        return is_same;
+    }
+
+    void free_decoded_pixels(const unsigned char* pixels){
+        stbi_image_free(const_cast<unsigned char*>(pixels));
+    }
+
+    void keep_packed_pixels(const unsigned char*){}
+
+    // magenta/black checker shown until the real pixels are uploaded
+    const unsigned char placeholder_pixels[2 * 2 * 4] = {
+        255, 0, 255, 255,   0, 0, 0, 255,
+        0, 0, 0, 255,       255, 0, 255, 255
+    };
+}
 
 ResourcesManager::ResourcesManager(const std::string& executable_path){
     size_t found = executable_path.find_last_of("/\\");
     m_path = executable_path.substr(0, found);
 }
 
-std::string ResourcesManager::get_file_path(const std::string& relative_path) const{
-    std::fstream file;
-    file.open(m_path + "/" + relative_path.c_str(), std::ios::in | std::ios::binary);
-    if(!file.is_open()){
-        std::cerr << "Failed to open file: " << relative_path << std::endl;
-        return std::string{};
+MappedFile ResourcesManager::get_file_path(const std::string& relative_path) const{
+    return MappedFile(m_path + "/" + relative_path);
+}
+
+std::string_view ResourcesManager::get_file_view(const std::string& relative_path, MappedFile& loose_file) const{
+    if (m_asset_pack){
+        if (const AssetPack::Entry* p_entry = m_asset_pack->find(relative_path, AssetPack::Type::Raw)){
+            return m_asset_pack->data(*p_entry);
+        }
     }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+    loose_file = get_file_path(relative_path);
+    return loose_file.view();
+}
+
+bool ResourcesManager::mount_pack(const std::string& pack_path){
+    auto asset_pack = std::make_shared<AssetPack>(m_path + "/" + pack_path);
+    if (!asset_pack->is_open()){
+        std::cerr << "Can't mount asset pack: " << pack_path << std::endl;
+        return false;
+    }
+    m_asset_pack = std::move(asset_pack);
+    return true;
 }
 
 std::shared_ptr<Renderer::ShaderProgram> ResourcesManager::load_shader(const::std::string& shader_name, const std::string& vertex_path, const std::string& fragment_path){
-    std::string vertex_string = get_file_path(vertex_path);
-    if(vertex_string.empty()){
+    MappedFile vertex_file;
+    const std::string_view vertex_source = get_file_view(vertex_path, vertex_file);
+    if(vertex_source.empty()){
         std::cerr << "No vertex shader." << std::endl;
         return nullptr;
     }
 
-    std::string fragment_string = get_file_path(fragment_path);
-    if(fragment_string.empty()){
+    MappedFile fragment_file;
+    const std::string_view fragment_source = get_file_view(fragment_path, fragment_file);
+    if(fragment_source.empty()){
         std::cerr << "No fragment shader." << std::endl;
         return nullptr;
     }
 
-    std::shared_ptr<Renderer::ShaderProgram>& new_shader = m_shader_program.emplace(shader_name, std::make_shared<Renderer::ShaderProgram>(vertex_string, fragment_string)).first->second;
+    const std::shared_ptr<Renderer::ShaderProgram>& new_shader = m_shaders.add(m_names.intern(shader_name), std::make_shared<Renderer::ShaderProgram>(vertex_source, fragment_source));
     if (new_shader->isCompiled()){
         return new_shader;
     }
@@ -49,103 +122,435 @@ std::shared_ptr<Renderer::ShaderProgram> ResourcesManager::load_shader(const::st
     return nullptr;
 }
 
-std::shared_ptr<Renderer::ShaderProgram> ResourcesManager::get_shader(const std::string& shader_name){
-    ShaderProgramsMap::const_iterator it = m_shader_program.find(shader_name);
-    if(it != m_shader_program.end()){
-        return it->second;
+std::shared_ptr<Renderer::ShaderProgram> ResourcesManager::get_shader(const ResourceName shader_name){
+    if (const std::shared_ptr<Renderer::ShaderProgram>& p_shader = m_shaders.get_shared(find_shader(shader_name))){
+        return p_shader;
     }
-    std::cerr << "Can't find shader: " << shader_name << std::endl;
+    std::cerr << "Can't find shader: " << shader_name.str() << std::endl;
     return nullptr;
 }
 
 std::shared_ptr<Renderer::Texture2D> ResourcesManager::load_texture(const std::string& texture_name, const std::string& texture_path){
+    const std::string full_path = std::filesystem::path(m_path + "/" + texture_path).lexically_normal().generic_string();
+    TexturesMap::const_iterator resident = m_textures_by_path.find(full_path);
+    if (resident != m_textures_by_path.end()){
+        ++m_aliased_texture_loads;
+        return m_textures.add(m_names.intern(texture_name), resident->second);
+    }
+
+    // packed textures are already decoded
+    if (m_asset_pack){
+        if (const AssetPack::Entry* p_entry = m_asset_pack->find(texture_path, AssetPack::Type::Texture)){
+            const std::string_view pixels = m_asset_pack->data(*p_entry);
+            std::shared_ptr<Renderer::Texture2D> new_texture = m_textures.add(m_names.intern(texture_name), std::make_shared<Renderer::Texture2D>(create_texture(
+                p_entry->width,
+                p_entry->height,
+                reinterpret_cast<const unsigned char*>(pixels.data()),
+                p_entry->channels)));
+            m_textures_by_path.emplace(full_path, new_texture);
+            return new_texture;
+        }
+    }
+
     int channels = 0;
     int width = 0;
     int height = 0;
     stbi_set_flip_vertically_on_load(true);
-    unsigned char* pixels = stbi_load(std::string(m_path + "/" + texture_path).c_str(), &width, &height, &channels, 0);
+    const MappedFile file(full_path);
+    unsigned char* pixels = file.size() == 0 ? nullptr : stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &channels, 0);
     if (!pixels){
         std::cerr << "Can't load texture: " << texture_path << std::endl;
         return nullptr;
     }
 
-    std::shared_ptr<Renderer::Texture2D> new_texture = m_textures.emplace(texture_name, std::make_shared<Renderer::Texture2D>(
+    uint64_t content_hash = 0;
+    if (m_deduplicate_by_content){
+        content_hash = hash_pixels(pixels, width, height, channels);
+        auto same_content = m_textures_by_content.find(content_hash);
+        if (same_content != m_textures_by_content.end() && has_same_pixels(same_content->second.first, pixels, width, height, channels)){
+            stbi_image_free(pixels);
+            ++m_aliased_texture_loads;
+            m_textures_by_path.emplace(full_path, same_content->second.second);
+            return m_textures.add(m_names.intern(texture_name), same_content->second.second);
+        }
+    }
+
+    std::shared_ptr<Renderer::Texture2D> new_texture = m_textures.add(m_names.intern(texture_name), std::make_shared<Renderer::Texture2D>(create_texture(
         width,
         height,
         pixels,
-        channels,
-        GL_NEAREST,
-        GL_CLAMP_TO_EDGE)).first->second;
+        channels)));
     stbi_image_free(pixels);
+    m_textures_by_path.emplace(full_path, new_texture);
+    if (m_deduplicate_by_content){
+        m_textures_by_content.emplace(content_hash, std::make_pair(full_path, new_texture));
+    }
     return new_texture;
 }
 
-std::shared_ptr<Renderer::Texture2D> ResourcesManager::get_texture(const std::string& texture_name){
-    TexturesMap::const_iterator it = m_textures.find(texture_name);
-    if(it != m_textures.end()){
-        return it->second;
+std::shared_ptr<Renderer::Texture2D> ResourcesManager::load_texture_async(const std::string& texture_name, const std::string& texture_path){
+    const std::string full_path = std::filesystem::path(m_path + "/" + texture_path).lexically_normal().generic_string();
+    TexturesMap::const_iterator resident = m_textures_by_path.find(full_path);
+    if (resident != m_textures_by_path.end()){
+        ++m_aliased_texture_loads;
+        return m_textures.add(m_names.intern(texture_name), resident->second);
+    }
+
+    std::shared_ptr<Renderer::Texture2D> p_texture = m_textures.add(m_names.intern(texture_name), std::make_shared<Renderer::Texture2D>(
+        2,
+        2,
+        placeholder_pixels,
+        4,
+        GL_NEAREST,
+        GL_CLAMP_TO_EDGE));
+    m_textures_by_path.emplace(full_path, p_texture);
+    ++m_pending_texture_loads;
+
+    // packed textures are already decoded and go straight to the upload queue
+    if (m_asset_pack){
+        if (const AssetPack::Entry* p_entry = m_asset_pack->find(texture_path, AssetPack::Type::Texture)){
+            const unsigned char* p_pixels = reinterpret_cast<const unsigned char*>(m_asset_pack->data(*p_entry).data());
+            std::lock_guard<std::mutex> lock(m_decoded_textures_mutex);
+            m_decoded_textures.push_back(DecodedTexture{p_texture, texture_path,
+                                                        static_cast<int>(p_entry->width), static_cast<int>(p_entry->height), static_cast<int>(p_entry->channels),
+                                                        {p_pixels, &keep_packed_pixels}});
+            return p_texture;
+        }
+    }
+
+    if (!m_thread_pool){
+        m_thread_pool = std::make_shared<ThreadPool>(ThreadPool::default_thread_count());
+    }
+    m_thread_pool->enqueue([this, p_texture, texture_path, full_path](){
+        DecodedTexture decoded{p_texture, texture_path, 0, 0, 0, {nullptr, &free_decoded_pixels}};
+        const MappedFile file(full_path);
+        stbi_set_flip_vertically_on_load_thread(true);
+        if (file.size() != 0){
+            decoded.p_pixels.reset(stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &decoded.width, &decoded.height, &decoded.channels, 0));
+        }
+        std::lock_guard<std::mutex> lock(m_decoded_textures_mutex);
+        m_decoded_textures.push_back(std::move(decoded));
+    });
+    return p_texture;
+}
+
+bool ResourcesManager::decode_texture(const std::string& texture_path, DecodedTexture& decoded){
+    decoded.path = texture_path;
+    if (m_asset_pack){
+        if (const AssetPack::Entry* p_entry = m_asset_pack->find(texture_path, AssetPack::Type::Texture)){
+            decoded.width = static_cast<int>(p_entry->width);
+            decoded.height = static_cast<int>(p_entry->height);
+            decoded.channels = static_cast<int>(p_entry->channels);
+            decoded.p_pixels = {reinterpret_cast<const unsigned char*>(m_asset_pack->data(*p_entry).data()), &keep_packed_pixels};
+            return true;
+        }
+    }
+    const MappedFile file = get_file_path(texture_path);
+    stbi_set_flip_vertically_on_load(true);
+    unsigned char* pixels = file.size() == 0 ? nullptr : stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &decoded.width, &decoded.height, &decoded.channels, 0);
+    decoded.p_pixels = {pixels, &free_decoded_pixels};
+    return pixels != nullptr;
+}
+
+std::shared_ptr<Renderer::TextureArray> ResourcesManager::load_texture_array(const std::string& array_name,
+                                                                             const std::vector<std::string>& sheet_paths,
+                                                                             const unsigned int width,
+                                                                             const unsigned int height){
+    struct Sheet{
+        DecodedTexture decoded{nullptr, std::string(), 0, 0, 0, {nullptr, &keep_packed_pixels}};
+        std::vector<std::string> tile_names;
+        std::vector<glm::vec4> tile_uv_rects;
+    };
+    std::vector<Sheet> sheets(sheet_paths.size());
+    unsigned int array_width = width;
+    unsigned int array_height = height;
+    for (size_t i = 0; i < sheet_paths.size(); ++i){
+        Sheet& sheet = sheets[i];
+        std::string texture_path = sheet_paths[i];
+        AtlasManifest manifest;
+        bool is_packed_atlas = false;
+        if (std::filesystem::path(texture_path).extension() == ".atlas"){
+            if (m_asset_pack){
+                if (const AssetPack::Entry* p_entry = m_asset_pack->find(sheet_paths[i], AssetPack::Type::Atlas)){
+                    // the pack checked the header, tile table and name ranges when it was opened
+                    const std::string_view blob = m_asset_pack->data(*p_entry);
+                    AssetPack::AtlasHeader header;
+                    std::memcpy(&header, blob.data(), sizeof(header));
+                    texture_path = std::string(blob.substr(header.texture_name_offset, header.texture_name_length));
+                    for (uint32_t tile_index = 0; tile_index < header.tile_count; ++tile_index){
+                        AssetPack::AtlasTile tile;
+                        std::memcpy(&tile, blob.data() + sizeof(header) + tile_index * sizeof(tile), sizeof(tile));
+                        sheet.tile_names.emplace_back(blob.substr(tile.name_offset, tile.name_length));
+                        sheet.tile_uv_rects.emplace_back(tile.left_bottom_uv[0], tile.left_bottom_uv[1], tile.right_top_uv[0], tile.right_top_uv[1]);
+                    }
+                    is_packed_atlas = true;
+                }
+            }
+            if (!is_packed_atlas){
+                const MappedFile manifest_file = get_file_path(sheet_paths[i]);
+                if (!parse_atlas_manifest(manifest_file.view(), manifest)){
+                    std::cerr << "Can't parse atlas manifest: " << sheet_paths[i] << std::endl;
+                    return nullptr;
+                }
+                texture_path = (std::filesystem::path(sheet_paths[i]).parent_path() / manifest.texture_path).generic_string();
+            }
+        }
+        if (!decode_texture(texture_path, sheet.decoded)){
+            std::cerr << "Can't load texture: " << texture_path << " for the texture array: " << array_name << std::endl;
+            return nullptr;
+        }
+        for (size_t tile_index = 0; tile_index < manifest.tiles.size(); ++tile_index){
+            glm::vec2 left_bottom_uv;
+            glm::vec2 right_top_uv;
+            grid_tile_uv(sheet.decoded.width, sheet.decoded.height, manifest.tile_width, manifest.tile_height, tile_index, left_bottom_uv, right_top_uv);
+            sheet.tile_names.push_back(manifest.tiles[tile_index]);
+            sheet.tile_uv_rects.emplace_back(left_bottom_uv, right_top_uv);
+        }
+        sheet.tile_names.push_back(std::filesystem::path(texture_path).stem().string());
+        sheet.tile_uv_rects.emplace_back(0.0f, 0.0f, 1.0f, 1.0f);
+        if (width == 0 || height == 0){
+            array_width = std::max(array_width, static_cast<unsigned int>(sheet.decoded.width));
+            array_height = std::max(array_height, static_cast<unsigned int>(sheet.decoded.height));
+        }
+    }
+
+    auto p_texture_array = std::make_shared<Renderer::TextureArray>(array_width, array_height, static_cast<GLuint>(sheets.size()));
+    for (size_t layer = 0; layer < sheets.size(); ++layer){
+        const Sheet& sheet = sheets[layer];
+        p_texture_array->set_layer(static_cast<GLuint>(layer), sheet.decoded.width, sheet.decoded.height,
+                                   sheet.decoded.p_pixels.get(), sheet.decoded.channels);
+        for (size_t tile_index = 0; tile_index < sheet.tile_names.size(); ++tile_index){
+            const glm::vec4& uv_rect = sheet.tile_uv_rects[tile_index];
+            p_texture_array->add_tile(sheet.tile_names[tile_index], static_cast<GLuint>(layer),
+                                      glm::vec2(uv_rect.x, uv_rect.y), glm::vec2(uv_rect.z, uv_rect.w));
+        }
+    }
+    return m_texture_arrays.add(m_names.intern(array_name), p_texture_array);
+}
+
+std::shared_ptr<Renderer::TextureArray> ResourcesManager::get_texture_array(const ResourceName array_name){
+    if (const std::shared_ptr<Renderer::TextureArray>& p_texture_array = m_texture_arrays.get_shared(find_texture_array(array_name))){
+        return p_texture_array;
     }
-    std::cerr << "Can't find textures: " << texture_name << std::endl;
+    std::cerr << "Can't find texture array: " << array_name.str() << std::endl;
+    return nullptr;
+}
+
+std::shared_ptr<Renderer::Texture2D> ResourcesManager::pack_texture(const std::string& texture_name, const std::string& texture_path){
+    if (const std::shared_ptr<Renderer::Texture2D>& p_resident = m_textures.get_shared(find_texture(texture_name))){
+        return p_resident;
+    }
+
+    DecodedTexture decoded{nullptr, std::string(), 0, 0, 0, {nullptr, &keep_packed_pixels}};
+    if (!decode_texture(texture_path, decoded)){
+        std::cerr << "Can't load texture: " << texture_path << std::endl;
+        return nullptr;
+    }
+    if (!m_dynamic_atlas){
+        m_dynamic_atlas = std::make_shared<Renderer::DynamicAtlas>();
+    }
+    const Renderer::DynamicAtlas::Region region = m_dynamic_atlas->add(texture_name, decoded.width, decoded.height,
+                                                                       decoded.p_pixels.get(), decoded.channels);
+    if (!region.is_valid()){
+        return load_texture(texture_name, texture_path);
+    }
+    return m_textures.add(m_names.intern(texture_name), region.p_page);
+}
+
+Renderer::Texture2D ResourcesManager::create_texture(const int width, const int height, const unsigned char* pixels, const int channels){
+    if (!m_texture_uploader){
+        m_texture_uploader = std::make_shared<Renderer::TextureUploader>();
+    }
+    const GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * channels;
+    const Renderer::TextureUploader::Staging staging = m_texture_uploader->reserve(size);
+    if (!staging.is_valid()){
+        return Renderer::Texture2D(width, height, pixels, channels, GL_NEAREST, GL_CLAMP_TO_EDGE);
+    }
+    std::memcpy(staging.p_data, pixels, size);
+    Renderer::Texture2D texture(width, height, nullptr, channels, GL_NEAREST, GL_CLAMP_TO_EDGE);
+    m_texture_uploader->upload(texture, staging);
+    return texture;
+}
+
+size_t ResourcesManager::process_uploads(const double budget_ms){
+    if (m_texture_uploader){
+        m_texture_uploader->poll();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    size_t uploads = 0;
+    while (m_pending_texture_loads > 0){
+        std::unique_lock<std::mutex> lock(m_decoded_textures_mutex);
+        if (m_decoded_textures.empty()){
+            break;
+        }
+        DecodedTexture decoded = std::move(m_decoded_textures.front());
+        m_decoded_textures.pop_front();
+        lock.unlock();
+
+        --m_pending_texture_loads;
+        if (!decoded.p_pixels){
+            std::cerr << "Can't load texture: " << decoded.path << std::endl;
+            continue;
+        }
+        // move assignment takes over the GL texture and keeps the placeholder's tiles
+        *decoded.p_texture = create_texture(decoded.width,
+                                            decoded.height,
+                                            decoded.p_pixels.get(),
+                                            decoded.channels);
+        ++uploads;
+        if (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >= budget_ms){
+            break;
+        }
+    }
+    return uploads;
+}
+
+std::shared_ptr<Renderer::Texture2D> ResourcesManager::get_texture(const ResourceName texture_name){
+    if (const std::shared_ptr<Renderer::Texture2D>& p_texture = m_textures.get_shared(find_texture(texture_name))){
+        return p_texture;
+    }
+    std::cerr << "Can't find textures: " << texture_name.str() << std::endl;
     return nullptr;
 }
 
 std::shared_ptr<Renderer::Sprite> ResourcesManager::load_sprite(const std::string& sprite_name,
-                                                                const std::string& texture_name,
-                                                                const std::string& shader_name,
+                                                                const ResourceName texture_name,
+                                                                const ResourceName shader_name,
                                                                 const unsigned int sprite_width,
                                                                 const unsigned int sprite_height,
-                                                                const std::string& tile_name){
+                                                                const ResourceName tile_name){
     auto texture = get_texture(texture_name);
     if (!texture){
-        std::cerr << "Can't find texture " << texture_name << " for the sprite: " << sprite_name << std::endl;
+        std::cerr << "Can't find texture " << texture_name.str() << " for the sprite: " << sprite_name << std::endl;
     }
 
     auto shader = get_shader(shader_name);
     if (!shader){
-        std::cerr << "Can't find shader " << shader_name << " for the sprite: " << sprite_name << std::endl;
+        std::cerr << "Can't find shader " << shader_name.str() << " for the sprite: " << sprite_name << std::endl;
     }
 
-    std::shared_ptr<Renderer::Sprite> new_sprite = m_sprites.emplace(texture_name, std::make_shared<Renderer::Sprite>(
+    std::shared_ptr<Renderer::Sprite> new_sprite = m_sprites.add(m_names.intern(sprite_name), std::make_shared<Renderer::Sprite>(
         texture,
         tile_name,
         shader,
+        get_quad_geometry(),
         glm::vec2(0.0f, 0.0f),
-        glm::vec2(sprite_width, sprite_height))).first->second;
+        glm::vec2(sprite_width, sprite_height)));
     return new_sprite;
 }
 
-std::shared_ptr<Renderer::Sprite> ResourcesManager::get_sprite(const std::string& sprite_name){
-    SpritesMap::const_iterator it = m_sprites.find(sprite_name);
-    if(it != m_sprites.end()){
-        return it->second;
+std::shared_ptr<Renderer::Sprite> ResourcesManager::get_sprite(const ResourceName sprite_name){
+    if (const std::shared_ptr<Renderer::Sprite>& p_sprite = m_sprites.get_shared(find_sprite(sprite_name))){
+        return p_sprite;
     }
-    std::cerr << "Can't find sprite: " << sprite_name << std::endl;
+    std::cerr << "Can't find sprite: " << sprite_name.str() << std::endl;
     return nullptr;
 }
 
+ShaderHandle ResourcesManager::find_shader(const ResourceName shader_name) const{
+    return m_shaders.find(m_names.find(shader_name));
+}
+
+TextureHandle ResourcesManager::find_texture(const ResourceName texture_name) const{
+    return m_textures.find(m_names.find(texture_name));
+}
+
+TextureArrayHandle ResourcesManager::find_texture_array(const ResourceName array_name) const{
+    return m_texture_arrays.find(m_names.find(array_name));
+}
+
+SpriteHandle ResourcesManager::find_sprite(const ResourceName sprite_name) const{
+    return m_sprites.find(m_names.find(sprite_name));
+}
+
+bool ResourcesManager::unload_shader(const ResourceName shader_name){
+    return m_shaders.remove(m_names.find(shader_name)) != nullptr;
+}
+
+bool ResourcesManager::unload_texture(const ResourceName texture_name){
+    const std::shared_ptr<Renderer::Texture2D> p_texture = m_textures.remove(m_names.find(texture_name));
+    if (!p_texture){
+        return false;
+    }
+    // the next load of the same file or pixels creates a fresh texture
+    for (auto it = m_textures_by_path.begin(); it != m_textures_by_path.end();){
+        it = it->second == p_texture ? m_textures_by_path.erase(it) : std::next(it);
+    }
+    for (auto it = m_textures_by_content.begin(); it != m_textures_by_content.end();){
+        it = it->second.second == p_texture ? m_textures_by_content.erase(it) : std::next(it);
+    }
+    return true;
+}
+
+bool ResourcesManager::unload_texture_array(const ResourceName array_name){
+    return m_texture_arrays.remove(m_names.find(array_name)) != nullptr;
+}
+
+bool ResourcesManager::unload_sprite(const ResourceName sprite_name){
+    return m_sprites.remove(m_names.find(sprite_name)) != nullptr;
+}
+
+std::shared_ptr<Renderer::QuadGeometry> ResourcesManager::get_quad_geometry(){
+    if (!m_quad_geometry){
+        m_quad_geometry = std::make_shared<Renderer::QuadGeometry>();
+    }
+    return m_quad_geometry;
+}
+
 std::shared_ptr<Renderer::Texture2D> ResourcesManager::load_texture_atlas(const std::string& texture_name,
                                                                           const std::string& texture_path,
                                                                           const std::vector<std::string> tile,
                                                                           const unsigned int tile_sheet_width,
-                                                                          const unsigned int tile_sheet_height){
+                                                                          const unsigned int tile_sheet_height,
+                                                                          std::vector<Renderer::TileId>* p_tile_ids){
     auto p_texture = load_texture(std::move(texture_name), std::move(texture_path));
     if (p_texture){
-        const unsigned int texture_width = p_texture->width();
-        const unsigned int texture_height = p_texture->height();
-        unsigned int tile_offset_x = 0;
-        unsigned int tile_offset_y = texture_height;
-        for (const auto& current_tile_name : tile){
-            glm::vec2 left_bottom_uv(static_cast<float>(tile_offset_x) / texture_width,
-                                     static_cast<float>(tile_offset_y - tile_sheet_height) / texture_height);
-            glm::vec2 right_top_uv(static_cast<float>(tile_offset_x + tile_sheet_width) / texture_width,
-                                   static_cast<float>(tile_offset_y) / texture_height);
-            p_texture->add_tile(std::move(current_tile_name), left_bottom_uv, right_top_uv);
-            tile_offset_x += tile_sheet_width;
-            if (tile_offset_x >= texture_width){
-                tile_offset_x = 0;
-                tile_offset_y -= tile_sheet_height;
+        for (size_t i = 0; i < tile.size(); ++i){
+            glm::vec2 left_bottom_uv;
+            glm::vec2 right_top_uv;
+            grid_tile_uv(p_texture->width(), p_texture->height(), tile_sheet_width, tile_sheet_height, i, left_bottom_uv, right_top_uv);
+            const Renderer::TileId tile_id = p_texture->add_tile(tile[i], left_bottom_uv, right_top_uv);
+            if (p_tile_ids){
+                p_tile_ids->push_back(tile_id);
             }
         }
     }
     return p_texture;
 }
+
+std::shared_ptr<Renderer::Texture2D> ResourcesManager::load_texture_atlas(const std::string& texture_name,
+                                                                          const std::string& atlas_path,
+                                                                          std::vector<Renderer::TileId>* p_tile_ids){
+    // a packed atlas carries its tile table precomputed
+    if (m_asset_pack){
+        if (const AssetPack::Entry* p_entry = m_asset_pack->find(atlas_path, AssetPack::Type::Atlas)){
+            // the pack checked the header, tile table and name ranges when it was opened
+            const std::string_view blob = m_asset_pack->data(*p_entry);
+            AssetPack::AtlasHeader header;
+            std::memcpy(&header, blob.data(), sizeof(header));
+            auto p_texture = load_texture(texture_name, std::string(blob.substr(header.texture_name_offset, header.texture_name_length)));
+            if (p_texture){
+                for (uint32_t i = 0; i < header.tile_count; ++i){
+                    AssetPack::AtlasTile tile;
+                    std::memcpy(&tile, blob.data() + sizeof(header) + i * sizeof(tile), sizeof(tile));
+                    const Renderer::TileId tile_id = p_texture->add_tile(std::string(blob.substr(tile.name_offset, tile.name_length)),
+                                                                         glm::vec2(tile.left_bottom_uv[0], tile.left_bottom_uv[1]),
+                                                                         glm::vec2(tile.right_top_uv[0], tile.right_top_uv[1]));
+                    if (p_tile_ids){
+                        p_tile_ids->push_back(tile_id);
+                    }
+                }
+            }
+            return p_texture;
+        }
+    }
+
+    const MappedFile manifest_file = get_file_path(atlas_path);
+    AtlasManifest manifest;
+    if (!parse_atlas_manifest(manifest_file.view(), manifest)){
+        std::cerr << "Can't parse atlas manifest: " << atlas_path << std::endl;
+        return nullptr;
+    }
+    const std::string texture_path = (std::filesystem::path(atlas_path).parent_path() / manifest.texture_path).generic_string();
+    return load_texture_atlas(texture_name, texture_path, std::move(manifest.tiles), manifest.tile_width, manifest.tile_height, p_tile_ids);
+}
@@ -3,12 +3,31 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "../renderer/tile_id.hpp"
+#include "name_table.hpp"
+#include "resource_name.hpp"
+#include "resource_handle.hpp"
+
+class MappedFile;
+class AssetPack;
+class ThreadPool;
 
 namespace Renderer{
     class ShaderProgram;
     class Texture2D;
     class Sprite;
+    class QuadGeometry;
+    class TextureUploader;
+    class TextureArray;
+    class DynamicAtlas;
 }
 
 class ResourcesManager{
@@ -21,39 +40,145 @@ public:
     ResourcesManager& operator=(ResourcesManager&&) = delete;
     ResourcesManager(ResourcesManager&&) = delete;
 
+    // Serves assets from a pack built by AssetPacker (path relative to the
+    // executable) before falling back to loose files under the same names.
+    bool mount_pack(const std::string& pack_path);
+
     std::shared_ptr<Renderer::ShaderProgram> load_shader(const::std::string& shader_name,
                                                          const std::string& vertex_path,
                                                          const std::string& fragment_path);
-    std::shared_ptr<Renderer::ShaderProgram> get_shader(const std::string& shader_name);
+    std::shared_ptr<Renderer::ShaderProgram> get_shader(const ResourceName shader_name);
 
+    // Returns the already resident texture when the same file, or a file with
+    // identical pixels, was loaded before under another name. The alias is the
+    // same Texture2D, so tiles added through either name (load_texture_atlas)
+    // show up in both, and add_tile keeps the first tile on a name clash.
     std::shared_ptr<Renderer::Texture2D> load_texture(const std::string& texture_name, const std::string& texture_path);
-    std::shared_ptr<Renderer::Texture2D> get_texture(const std::string& texture_name);
+    std::shared_ptr<Renderer::Texture2D> get_texture(const ResourceName texture_name);
+    // Returns a placeholder at once and decodes on a worker thread; the GL upload
+    // happens in process_uploads, which swaps the real pixels into the same
+    // Texture2D so sprites created from the placeholder pick them up.
+    std::shared_ptr<Renderer::Texture2D> load_texture_async(const std::string& texture_name, const std::string& texture_path);
+    // Uploads decoded textures on the GL thread until budget_ms is spent (at least one per call).
+    size_t process_uploads(const double budget_ms);
+    size_t pending_texture_loads() const {return m_pending_texture_loads;}
+    // Staging ring used for every texture upload; null until the first texture is loaded.
+    std::shared_ptr<Renderer::TextureUploader> get_texture_uploader() const {return m_texture_uploader;}
+    void set_deduplicate_by_content(const bool deduplicate) {m_deduplicate_by_content = deduplicate;}
+    size_t aliased_texture_loads() const {return m_aliased_texture_loads;}
+
+    // Places every sheet (a texture, or a *.atlas manifest with its tiles) in
+    // its own layer of one array so sprites from all of them batch together.
+    // Each sheet also gets a whole-layer tile named after its file stem. The
+    // array is sized to the largest sheet unless width / height are given;
+    // smaller sheets are padded.
+    std::shared_ptr<Renderer::TextureArray> load_texture_array(const std::string& array_name,
+                                                               const std::vector<std::string>& sheet_paths,
+                                                               const unsigned int width = 0,
+                                                               const unsigned int height = 0);
+    std::shared_ptr<Renderer::TextureArray> get_texture_array(const ResourceName array_name);
+
+    // Packs a loose image into a shared page of the dynamic atlas instead of
+    // giving it a texture of its own: texture_name then refers to the page and
+    // the image is its tile of the same name, so
+    // load_sprite(sprite, texture_name, shader, w, h, texture_name) draws it.
+    // Images larger than a page fall back to load_texture.
+    std::shared_ptr<Renderer::Texture2D> pack_texture(const std::string& texture_name, const std::string& texture_path);
+    // Null until the first image is packed.
+    std::shared_ptr<Renderer::DynamicAtlas> get_dynamic_atlas() const {return m_dynamic_atlas;}
 
     std::shared_ptr<Renderer::Sprite> load_sprite(const std::string& sprite_name,
-                                                  const std::string& texture_name,
-                                                  const std::string& shader_name,
+                                                  const ResourceName texture_name,
+                                                  const ResourceName shader_name,
                                                   const unsigned int sprite_width,
                                                   const unsigned int sprite_height,
-                                                  const std::string& tile_name = "default");
-    std::shared_ptr<Renderer::Sprite> get_sprite(const std::string& sprite_name);
+                                                  const ResourceName tile_name = "default");
+    std::shared_ptr<Renderer::Sprite> get_sprite(const ResourceName sprite_name);
+
+    std::shared_ptr<Renderer::QuadGeometry> get_quad_geometry();
+
+    // Handles resolve with an index and a generation check and hand out raw
+    // pointers, so hot paths touch neither strings nor reference counts; the
+    // string getters above are a layer over them for setup code and tooling.
+    // A handle stops resolving once its resource is unloaded.
+    NameId intern_name(const std::string_view name) {return m_names.intern(name);}
+    ShaderHandle find_shader(const ResourceName shader_name) const;
+    ShaderHandle find_shader(const NameId shader_name) const {return m_shaders.find(shader_name);}
+    TextureHandle find_texture(const ResourceName texture_name) const;
+    TextureHandle find_texture(const NameId texture_name) const {return m_textures.find(texture_name);}
+    TextureArrayHandle find_texture_array(const ResourceName array_name) const;
+    TextureArrayHandle find_texture_array(const NameId array_name) const {return m_texture_arrays.find(array_name);}
+    SpriteHandle find_sprite(const ResourceName sprite_name) const;
+    SpriteHandle find_sprite(const NameId sprite_name) const {return m_sprites.find(sprite_name);}
+    Renderer::ShaderProgram* get(const ShaderHandle handle) const {return m_shaders.get(handle);}
+    Renderer::Texture2D* get(const TextureHandle handle) const {return m_textures.get(handle);}
+    Renderer::TextureArray* get(const TextureArrayHandle handle) const {return m_texture_arrays.get(handle);}
+    Renderer::Sprite* get(const SpriteHandle handle) const {return m_sprites.get(handle);}
 
+    // Drop the manager's reference; whoever still holds a shared_ptr keeps the resource alive.
+    bool unload_shader(const ResourceName shader_name);
+    bool unload_texture(const ResourceName texture_name);
+    bool unload_texture_array(const ResourceName array_name);
+    bool unload_sprite(const ResourceName sprite_name);
+
+    // Both overloads write the TileId of every tile, in tile order, to p_tile_ids if given.
     std::shared_ptr<Renderer::Texture2D> load_texture_atlas(const std::string& texture_name,
                                                             const std::string& texture_path,
                                                             const std::vector<std::string> tile,
                                                             const unsigned int tile_sheet_width,
-                                                            const unsigned int tile_sheet_height);
+                                                            const unsigned int tile_sheet_height,
+                                                            std::vector<Renderer::TileId>* p_tile_ids = nullptr);
+    // Loads the texture and tiles described by a *.atlas manifest.
+    std::shared_ptr<Renderer::Texture2D> load_texture_atlas(const std::string& texture_name,
+                                                            const std::string& atlas_path,
+                                                            std::vector<Renderer::TileId>* p_tile_ids = nullptr);
 
 private:
-    std::string get_file_path(const std::string& relative_path) const;
+    MappedFile get_file_path(const std::string& relative_path) const;
+    // Contents of a Raw pack entry, or of the loose file mapped into loose_file.
+    std::string_view get_file_view(const std::string& relative_path, MappedFile& loose_file) const;
+
+    // Allocates the texture and uploads the pixels through the staging ring.
+    Renderer::Texture2D create_texture(const int width, const int height, const unsigned char* pixels, const int channels);
+
+    struct DecodedTexture;
+    // Decoded pixels of a packed or loose texture; false if it can't be read.
+    bool decode_texture(const std::string& texture_path, DecodedTexture& decoded);
 
-    typedef std::map<const std::string, std::shared_ptr<Renderer::ShaderProgram>> ShaderProgramsMap;
-    ShaderProgramsMap m_shader_program;
+    struct DecodedTexture{
+        std::shared_ptr<Renderer::Texture2D> p_texture;
+        std::string path;
+        int width;
+        int height;
+        int channels;
+        // stbi_image_free for decoded files, a no-op for pixels inside the asset pack
+        std::unique_ptr<const unsigned char, void(*)(const unsigned char*)> p_pixels;
+    };
+
+    NameTable m_names;
+    ResourceRegistry<Renderer::ShaderProgram> m_shaders;
+    ResourceRegistry<Renderer::Texture2D> m_textures;
+    ResourceRegistry<Renderer::TextureArray> m_texture_arrays;
+    ResourceRegistry<Renderer::Sprite> m_sprites;
 
     typedef std::map<const std::string, std::shared_ptr<Renderer::Texture2D>> TexturesMap;
-    TexturesMap m_textures;
+    TexturesMap m_textures_by_path;
+    // pixel hash -> (file the pixels were decoded from, texture)
+    std::unordered_map<uint64_t, std::pair<std::string, std::shared_ptr<Renderer::Texture2D>>> m_textures_by_content;
+
+    std::shared_ptr<Renderer::DynamicAtlas> m_dynamic_atlas;
+    bool m_deduplicate_by_content = true;
+    size_t m_aliased_texture_loads = 0;
 
-    typedef std::map<const std::string, std::shared_ptr<Renderer::Sprite>> SpritesMap;
-    SpritesMap m_sprites;
+    std::shared_ptr<Renderer::QuadGeometry> m_quad_geometry;
+    std::shared_ptr<AssetPack> m_asset_pack;
+    std::shared_ptr<Renderer::TextureUploader> m_texture_uploader;
 
     std::string m_path;
+
+    std::mutex m_decoded_textures_mutex;
+    std::deque<DecodedTexture> m_decoded_textures;
+    size_t m_pending_texture_loads = 0;
+    // declared last so the workers are joined before anything they write to is destroyed
+    std::shared_ptr<ThreadPool> m_thread_pool;
 };
\ No newline at end of file
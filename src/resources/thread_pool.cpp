@@ -0,0 +1,50 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(const size_t thread_count){
+    m_threads.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i){
+        m_threads.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_is_stopping = true;
+    }
+    m_condition.notify_all();
+    for (std::thread& thread : m_threads){
+        thread.join();
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> job){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+size_t ThreadPool::default_thread_count(){
+    const size_t hardware_threads = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, hardware_threads > 1 ? hardware_threads - 1 : 1);
+}
+
+void ThreadPool::work(){
+    while (true){
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this](){return m_is_stopping || !m_jobs.empty();});
+            if (m_jobs.empty()){
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
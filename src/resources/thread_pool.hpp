@@ -0,0 +1,34 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running queued jobs in FIFO order. The
+// destructor finishes the jobs already queued before joining.
+class ThreadPool{
+public:
+    explicit ThreadPool(const size_t thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void enqueue(std::function<void()> job);
+    size_t thread_count() const {return m_threads.size();}
+
+    // hardware threads minus the one running the game loop, at least one
+    static size_t default_thread_count();
+
+private:
+    void work();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_is_stopping = false;
+};
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include "../src/resources/stb_image.h"
+
+#include "../src/resources/asset_pack.hpp"
+#include "../src/resources/mapped_file.hpp"
+
+// Builds an asset pack (see asset_pack.hpp) from a directory tree:
+//   AssetPacker <input directory> <output file>
+// Entry names are paths relative to the parent of the input directory, so
+// packing "res" yields the same names the game passes to ResourcesManager.
+// *.png files are decoded, *.atlas manifests are compiled into tile tables
+// and every other file is stored as is.
+
+namespace{
+    struct PendingEntry{
+        std::string name;
+        AssetPack::Entry entry;
+        std::string blob;
+    };
+
+    void append(std::string& blob, const void* p_data, const size_t size){
+        blob.append(static_cast<const char*>(p_data), size);
+    }
+
+    bool pack_texture(const std::filesystem::path& path, PendingEntry& pending){
+        const MappedFile file(path.string());
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        stbi_set_flip_vertically_on_load(true);
+        unsigned char* pixels = file.size() == 0 ? nullptr : stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &channels, 0);
+        if (!pixels){
+            std::cerr << "Can't decode texture: " << path.string() << std::endl;
+            return false;
+        }
+        pending.entry.type = AssetPack::Type::Texture;
+        pending.entry.width = width;
+        pending.entry.height = height;
+        pending.entry.channels = channels;
+        append(pending.blob, pixels, static_cast<size_t>(width) * height * channels);
+        stbi_image_free(pixels);
+        return true;
+    }
+
+    bool pack_atlas(const std::filesystem::path& path, const std::filesystem::path& root, PendingEntry& pending){
+        const MappedFile file(path.string());
+        AtlasManifest manifest;
+        if (!parse_atlas_manifest(file.view(), manifest)){
+            std::cerr << "Can't parse atlas manifest: " << path.string() << std::endl;
+            return false;
+        }
+        const std::filesystem::path texture_path = path.parent_path() / manifest.texture_path;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        if (!stbi_info(texture_path.string().c_str(), &width, &height, &channels)){
+            std::cerr << "Can't read texture " << texture_path.string() << " of atlas: " << path.string() << std::endl;
+            return false;
+        }
+        const std::string texture_name = AssetPack::normalize_name(texture_path.lexically_relative(root).generic_string());
+
+        const uint32_t tile_count = static_cast<uint32_t>(manifest.tiles.size());
+        uint32_t string_offset = static_cast<uint32_t>(sizeof(AssetPack::AtlasHeader) + tile_count * sizeof(AssetPack::AtlasTile));
+        const AssetPack::AtlasHeader header{tile_count, string_offset, static_cast<uint32_t>(texture_name.size())};
+        append(pending.blob, &header, sizeof(header));
+        std::string strings = texture_name;
+        string_offset += static_cast<uint32_t>(texture_name.size());
+        for (size_t i = 0; i < manifest.tiles.size(); ++i){
+            glm::vec2 left_bottom_uv;
+            glm::vec2 right_top_uv;
+            grid_tile_uv(width, height, manifest.tile_width, manifest.tile_height, i, left_bottom_uv, right_top_uv);
+            const AssetPack::AtlasTile tile{{left_bottom_uv.x, left_bottom_uv.y}, {right_top_uv.x, right_top_uv.y},
+                                            string_offset, static_cast<uint32_t>(manifest.tiles[i].size())};
+            append(pending.blob, &tile, sizeof(tile));
+            strings += manifest.tiles[i];
+            string_offset += static_cast<uint32_t>(manifest.tiles[i].size());
+        }
+        pending.blob += strings;
+        pending.entry.type = AssetPack::Type::Atlas;
+        return true;
+    }
+
+    void pad(std::ofstream& out, uint64_t& offset, const uint64_t alignment){
+        static const char zeros[AssetPack::blob_alignment] = {};
+        const uint64_t padding = (alignment - offset % alignment) % alignment;
+        out.write(zeros, padding);
+        offset += padding;
+    }
+}
+
+int main(int argc, char** argv){
+    if (argc != 3){
+        std::cerr << "Usage: " << argv[0] << " <input directory> <output file>" << std::endl;
+        return 1;
+    }
+    const std::filesystem::path input = std::filesystem::absolute(argv[1]).lexically_normal();
+    // names are relative to the parent, so they keep the "res/" prefix
+    const std::filesystem::path root = input.has_filename() ? input.parent_path() : input.parent_path().parent_path();
+    if (!std::filesystem::is_directory(input)){
+        std::cerr << "Not a directory: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::vector<PendingEntry> entries;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(input)){
+        if (!item.is_regular_file()){
+            continue;
+        }
+        const std::filesystem::path& path = item.path();
+        PendingEntry pending;
+        pending.name = AssetPack::normalize_name(path.lexically_relative(root).generic_string());
+        pending.entry = AssetPack::Entry{};
+        bool is_packed = false;
+        if (path.extension() == ".png"){
+            is_packed = pack_texture(path, pending);
+        }else if (path.extension() == ".atlas"){
+            is_packed = pack_atlas(path, root, pending);
+        }else{
+            const MappedFile file(path.string());
+            is_packed = file.is_open();
+            pending.entry.type = AssetPack::Type::Raw;
+            pending.blob.assign(file.view());
+        }
+        if (!is_packed){
+            return 1;
+        }
+        entries.push_back(std::move(pending));
+    }
+    std::sort(entries.begin(), entries.end(), [](const PendingEntry& a, const PendingEntry& b){
+        return a.name < b.name;
+    });
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out){
+        std::cerr << "Can't open output file: " << argv[2] << std::endl;
+        return 1;
+    }
+
+    AssetPack::Header header{};
+    std::memcpy(header.magic, AssetPack::magic, sizeof(header.magic));
+    header.version = AssetPack::version;
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t offset = sizeof(header);
+
+    std::string names;
+    for (PendingEntry& pending : entries){
+        pad(out, offset, AssetPack::blob_alignment);
+        pending.entry.offset = offset;
+        pending.entry.size = pending.blob.size();
+        pending.entry.name_offset = static_cast<uint32_t>(names.size());
+        pending.entry.name_length = static_cast<uint32_t>(pending.name.size());
+        names += pending.name;
+        out.write(pending.blob.data(), pending.blob.size());
+        offset += pending.blob.size();
+    }
+
+    pad(out, offset, alignof(AssetPack::Entry));
+    header.entries_offset = offset;
+    for (const PendingEntry& pending : entries){
+        out.write(reinterpret_cast<const char*>(&pending.entry), sizeof(pending.entry));
+        offset += sizeof(pending.entry);
+    }
+    header.names_offset = offset;
+    header.names_size = static_cast<uint32_t>(names.size());
+    out.write(names.data(), names.size());
+    offset += names.size();
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out){
+        std::cerr << "Failed to write: " << argv[2] << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << entries.size() << " assets, " << offset << " bytes: " << argv[2] << std::endl;
+    return 0;
+}